@@ -20,6 +20,9 @@
 // Project
 #include <Alarm.h>
 
+// C++
+#include <algorithm>
+
 //-----------------------------------------------------------------
 QString Alarm::AlarmTime::text() const
 {
@@ -102,6 +105,35 @@ const Alarm::AlarmTime Alarm::remainingTime() const
   return m_remainingTime;
 }
 
+//-----------------------------------------------------------------
+long long Alarm::remainingSeconds() const
+{
+  constexpr long long secondsInHour = 60*60;
+  constexpr long long secondsInDay  = 24*secondsInHour;
+
+  return (m_remainingTime.days * secondsInDay) + (m_remainingTime.hours * secondsInHour) + (m_remainingTime.minutes * 60) + m_remainingTime.seconds;
+}
+
+//-----------------------------------------------------------------
+void Alarm::setRemainingSeconds(long long seconds)
+{
+  constexpr long long secondsInHour = 60*60;
+  constexpr long long secondsInDay  = 24*secondsInHour;
+
+  const auto total = (m_time.days * secondsInDay) + (m_time.hours * secondsInHour) + (m_time.minutes * 60) + m_time.seconds;
+  seconds = std::max(1LL, std::min(seconds, total));
+
+  m_remainingTime = AlarmTime(seconds / secondsInDay, (seconds % secondsInDay) / secondsInHour, (seconds % secondsInHour) / 60, seconds % 60);
+
+  computeProgressValues();
+}
+
+//-----------------------------------------------------------------
+unsigned int Alarm::completedIntervals() const
+{
+  return m_intervals;
+}
+
 //-----------------------------------------------------------------
 const Alarm::AlarmTime Alarm::time() const
 {
@@ -102,6 +102,17 @@ class Alarm
      */
     const AlarmTime remainingTime() const;
 
+    /** \brief Returns the remaining time of the alarm in seconds.
+     *
+     */
+    long long remainingSeconds() const;
+
+    /** \brief Sets the remaining time of the alarm, used to resume a countdown.
+     * \param[in] seconds remaining time in seconds in [1, duration].
+     *
+     */
+    void setRemainingSeconds(long long seconds);
+
     /** \brief Returns the duration of the alarm.
      *
      */
@@ -0,0 +1,81 @@
+/*
+ File: AlarmConfiguration.h
+ Created on: 19/10/2026
+ Author: Felix de las Pozas Alvarez
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ALARMCONFIGURATION_H_
+#define ALARMCONFIGURATION_H_
+
+// Qt
+#include <QString>
+#include <QTime>
+#include <QDateTime>
+#include <QPoint>
+#include <QMetaType>
+
+/** \struct AlarmState
+ * \brief Holds the run state of a timer alarm, stored to resume the countdown after a restart.
+ */
+struct AlarmState
+{
+    enum class Status: quint8 { STOPPED = 0, RUNNING, PAUSED };
+
+    Status status    = Status::STOPPED; /** run status of the timer.                                   */
+    qint64 deadline  = 0;               /** timeout time in msecs since epoch if running.               */
+    qint64 remaining = 0;               /** remaining time in seconds if paused.                        */
+};
+
+/** \struct AlarmConfiguration
+ * \brief Holds all the relevant information about an alarm and it's notifications.
+ */
+struct AlarmConfiguration
+{
+    QString   name;                     /** name of the alarm.                                            */
+    QString   message;                  /** message of the alarm to show on completion.                   */
+    QString   color;                    /** name of the color of the alarm.                               */
+    QString   group;                    /** name of the group of the alarm, empty if not grouped.         */
+    bool      isTimer          = false; /** true if the alarm is a timer.                                 */
+    QTime     timerTime;                /** duration of the timer alarm.                                  */
+    bool      timerLoops       = false; /** true if the timer loops.                                      */
+    QDateTime clockDateTime;            /** date and timer of the clock alarm.                            */
+    int       sound            = 0;     /** sound used for the finished alarm notification.               */
+    QString   soundFile;                /** user sound file used instead of the sound, empty if none.     */
+    int       soundVolume      = 100;   /** volume for the sound in [0 (silence) - 100 (loudest) ]        */
+    bool      useTray          = false; /** true if the alarm uses the tray for notifications.            */
+    bool      useDesktopWidget = false; /** true if the alarm uses a desktop widget for notifications.    */
+    bool      useLogiled       = false; /** true if the alarm uses the keyboard lights for notifications. */
+    QPoint    widgetPosition;           /** position of the desktop widget.                               */
+    int       widgetOpacity    = 60;    /** opacity of the desktop widget in [0-100]                      */
+    AlarmState state;                   /** run state of the timer alarm.                                 */
+
+    /** \brief Returns true if both alarms have the same definition. The run state is not compared.
+     * \param[in] other alarm configuration.
+     *
+     */
+    bool sameDefinition(const AlarmConfiguration &other) const
+    {
+      return name == other.name && message == other.message && color == other.color && group == other.group &&
+             isTimer == other.isTimer && timerTime == other.timerTime && timerLoops == other.timerLoops &&
+             clockDateTime == other.clockDateTime && sound == other.sound && soundFile == other.soundFile &&
+             soundVolume == other.soundVolume && useTray == other.useTray && useDesktopWidget == other.useDesktopWidget &&
+             useLogiled == other.useLogiled && widgetPosition == other.widgetPosition && widgetOpacity == other.widgetOpacity;
+    }
+};
+
+Q_DECLARE_METATYPE(AlarmConfiguration)
+
+#endif // ALARMCONFIGURATION_H_
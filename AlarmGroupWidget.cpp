@@ -0,0 +1,307 @@
+/*
+ File: AlarmGroupWidget.cpp
+ Created on: 19/10/2026
+ Author: Felix de las Pozas Alvarez
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Project
+#include <AlarmGroupWidget.h>
+#include <AlarmWidget.h>
+#include <Alarm.h>
+#include <Utils.h>
+
+// Qt
+#include <QLabel>
+#include <QToolButton>
+#include <QVBoxLayout>
+#include <QHBoxLayout>
+#include <QContextMenuEvent>
+#include <QMenu>
+#include <QActionGroup>
+#include <QDateTime>
+
+const int AlarmGroupWidget::HEADER_HEIGHT = 30;
+
+//-----------------------------------------------------------------
+AlarmGroupWidget::AlarmGroupWidget(const QString &name, QWidget *parent)
+: QWidget     {parent}
+, m_name      {name}
+, m_collapsed {false}
+, m_aggregate {Aggregate::MEAN}
+, m_sum       {0}
+, m_shown     {-1}
+{
+  auto layout = new QVBoxLayout(this);
+  layout->setContentsMargins(0,0,0,0);
+  layout->setSpacing(0);
+
+  m_header = new DrawFrame(this);
+  m_header->setFixedHeight(HEADER_HEIGHT);
+  m_header->setColors(QColor("lightgray"), QColor("white"));
+
+  auto headerLayout = new QHBoxLayout(m_header);
+  headerLayout->setContentsMargins(4,0,8,0);
+
+  m_collapse = new QToolButton(m_header);
+  m_collapse->setAutoRaise(true);
+  m_collapse->setArrowType(Qt::DownArrow);
+  m_collapse->setToolTip(tr("Collapse group"));
+
+  m_title = new QLabel(QString("<b>%1</b>").arg(name.toHtmlEscaped()), m_header);
+  m_summaryLabel = new QLabel(m_header);
+  m_summaryLabel->setAlignment(Qt::AlignRight|Qt::AlignVCenter);
+
+  headerLayout->addWidget(m_collapse);
+  headerLayout->addWidget(m_title, 1);
+  headerLayout->addWidget(m_summaryLabel, 1);
+
+  m_members = new QWidget(this);
+  m_membersLayout = new QVBoxLayout(m_members);
+  m_membersLayout->setContentsMargins(0,0,0,0);
+  m_membersLayout->setSpacing(0);
+
+  layout->addWidget(m_header);
+  layout->addWidget(m_members);
+
+  setToolTip(name + tr(" Group"));
+
+  connect(m_collapse, SIGNAL(clicked(bool)),
+          this,       SLOT(onCollapsePressed()));
+
+  updateHeader();
+}
+
+//-----------------------------------------------------------------
+void AlarmGroupWidget::addAlarm(AlarmWidget *widget)
+{
+  if(!widget || contains(widget)) return;
+
+  m_alarms << widget;
+  m_membersLayout->addWidget(widget);
+
+  m_progress.insert(widget, 0);
+  ++m_values[0];
+  setProgress(widget, widget->progress());
+  setDeadline(widget);
+
+  connect(widget, SIGNAL(progressChanged(double)),
+          this,   SLOT(onAlarmProgress(double)));
+
+  connect(widget, SIGNAL(stateChanged()),
+          this,   SLOT(onAlarmStateChanged()));
+
+  updateHeader();
+}
+
+//-----------------------------------------------------------------
+void AlarmGroupWidget::removeAlarm(AlarmWidget *widget)
+{
+  if(!contains(widget)) return;
+
+  disconnect(widget, nullptr, this, nullptr);
+
+  const auto value = m_progress.take(widget);
+  m_sum -= value;
+  if(--m_values[value] == 0) m_values.remove(value);
+
+  if(m_deadline.contains(widget))
+  {
+    const auto deadline = m_deadline.take(widget);
+    if(--m_deadlines[deadline] == 0) m_deadlines.remove(deadline);
+  }
+
+  m_alarms.removeOne(widget);
+  m_membersLayout->removeWidget(widget);
+
+  if(m_alarms.isEmpty())
+    m_sum = 0; // drop accumulated rounding errors.
+
+  updateHeader();
+}
+
+//-----------------------------------------------------------------
+void AlarmGroupWidget::setCollapsed(bool value)
+{
+  if(m_collapsed == value) return;
+
+  m_collapsed = value;
+
+  // Hidden members are not painted and skip their label updates.
+  m_members->setVisible(!value);
+  m_collapse->setArrowType(value ? Qt::RightArrow : Qt::DownArrow);
+  m_collapse->setToolTip(value ? tr("Expand group") : tr("Collapse group"));
+
+  emit collapsedChanged(value);
+}
+
+//-----------------------------------------------------------------
+void AlarmGroupWidget::setAggregate(const Aggregate aggregate)
+{
+  if(m_aggregate != aggregate)
+  {
+    m_aggregate = aggregate;
+    updateHeader();
+  }
+}
+
+//-----------------------------------------------------------------
+void AlarmGroupWidget::contextMenuEvent(QContextMenuEvent *e)
+{
+  if(!m_header->geometry().contains(e->pos()))
+  {
+    QWidget::contextMenuEvent(e);
+    return;
+  }
+
+  QMenu menu;
+  auto start  = menu.addAction(QIcon(":/MultiAlarm/play.svg"), tr("Start group"));
+  auto pause  = menu.addAction(QIcon(":/MultiAlarm/pause.svg"), tr("Pause group"));
+  auto stop   = menu.addAction(QIcon(":/MultiAlarm/stop.svg"), tr("Stop group"));
+  auto remove = menu.addAction(QIcon(":/MultiAlarm/delete.ico"), tr("Delete group"));
+  menu.addSeparator();
+
+  auto aggregates = new QActionGroup(&menu);
+  auto minimum = menu.addAction(tr("Show minimum progress"));
+  auto maximum = menu.addAction(tr("Show maximum progress"));
+  auto mean    = menu.addAction(tr("Show mean progress"));
+  for(auto action: {minimum, maximum, mean})
+  {
+    action->setCheckable(true);
+    aggregates->addAction(action);
+  }
+  minimum->setChecked(m_aggregate == Aggregate::MINIMUM);
+  maximum->setChecked(m_aggregate == Aggregate::MAXIMUM);
+  mean->setChecked(m_aggregate == Aggregate::MEAN);
+
+  auto selected = menu.exec(e->globalPos());
+
+  if(selected == start)        emit startGroup();
+  else if(selected == pause)   emit pauseGroup();
+  else if(selected == stop)    emit stopGroup();
+  else if(selected == remove)  emit deleteGroup();
+  else if(selected == minimum) setAggregate(Aggregate::MINIMUM);
+  else if(selected == maximum) setAggregate(Aggregate::MAXIMUM);
+  else if(selected == mean)    setAggregate(Aggregate::MEAN);
+}
+
+//-----------------------------------------------------------------
+void AlarmGroupWidget::onAlarmProgress(double value)
+{
+  auto widget = qobject_cast<AlarmWidget *>(sender());
+  if(!contains(widget)) return;
+
+  setProgress(widget, value);
+  updateHeader();
+}
+
+//-----------------------------------------------------------------
+void AlarmGroupWidget::onAlarmStateChanged()
+{
+  auto widget = qobject_cast<AlarmWidget *>(sender());
+  if(!contains(widget)) return;
+
+  setDeadline(widget);
+  updateHeader();
+}
+
+//-----------------------------------------------------------------
+void AlarmGroupWidget::onCollapsePressed()
+{
+  setCollapsed(!m_collapsed);
+}
+
+//-----------------------------------------------------------------
+void AlarmGroupWidget::setProgress(AlarmWidget *widget, double value)
+{
+  auto &current = m_progress[widget];
+  if(current == value) return;
+
+  if(--m_values[current] == 0) m_values.remove(current);
+  ++m_values[value];
+
+  m_sum += value - current;
+  current = value;
+}
+
+//-----------------------------------------------------------------
+void AlarmGroupWidget::setDeadline(AlarmWidget *widget)
+{
+  if(m_deadline.contains(widget))
+  {
+    const auto deadline = m_deadline.take(widget);
+    if(--m_deadlines[deadline] == 0) m_deadlines.remove(deadline);
+  }
+
+  const auto deadline = widget->deadline();
+  if(deadline.isValid())
+  {
+    const auto msecs = deadline.toMSecsSinceEpoch();
+    m_deadline.insert(widget, msecs);
+    ++m_deadlines[msecs];
+  }
+}
+
+//-----------------------------------------------------------------
+void AlarmGroupWidget::updateHeader()
+{
+  double value = 0;
+  QString text;
+
+  if(!m_values.isEmpty())
+  {
+    switch(m_aggregate)
+    {
+      case Aggregate::MINIMUM:
+        value = m_values.firstKey();
+        text = tr("Min");
+        break;
+      case Aggregate::MAXIMUM:
+        value = m_values.lastKey();
+        text = tr("Max");
+        break;
+      default:
+      case Aggregate::MEAN:
+        value = std::max(0., m_sum / m_alarms.size());
+        text = tr("Mean");
+        break;
+    }
+  }
+
+  text = QString("%1 %2%").arg(text).arg(static_cast<int>(value));
+
+  if(!m_deadlines.isEmpty())
+  {
+    const auto remaining = std::max(0LL, (m_deadlines.firstKey() - QDateTime::currentMSecsSinceEpoch() + 500) / 1000);
+    const Alarm::AlarmTime time(remaining / 86400, (remaining % 86400) / 3600, (remaining % 3600) / 60, remaining % 60);
+    text += tr(" - Next %1").arg(time.text());
+  }
+
+  text = QString("%1 (%2)").arg(text).arg(m_alarms.size());
+
+  if(text != m_summary)
+  {
+    m_summary = text;
+    m_summaryLabel->setText(text);
+  }
+
+  const auto shown = static_cast<int>(value * 10);
+  if(shown != m_shown)
+  {
+    m_shown = shown;
+    m_header->setProgress(value / 100.);
+    m_header->update();
+  }
+}
@@ -0,0 +1,192 @@
+/*
+ File: AlarmGroupWidget.h
+ Created on: 19/10/2026
+ Author: Felix de las Pozas Alvarez
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ALARMGROUPWIDGET_H_
+#define ALARMGROUPWIDGET_H_
+
+// Qt
+#include <QWidget>
+#include <QHash>
+#include <QMap>
+
+class AlarmWidget;
+class DrawFrame;
+class QLabel;
+class QToolButton;
+class QVBoxLayout;
+class QContextMenuEvent;
+
+/** \class AlarmGroupWidget
+ * \brief Collapsible section of the main window holding the alarms of a group and
+ *        showing the aggregated progress of its members.
+ *
+ */
+class AlarmGroupWidget
+: public QWidget
+{
+    Q_OBJECT
+  public:
+    static const int HEADER_HEIGHT; /** height of the group header in pixels. */
+
+    /** \brief Aggregation of the progress values of the members.
+     *
+     */
+    enum class Aggregate: char { MINIMUM = 0, MAXIMUM, MEAN };
+
+    /** \brief AlarmGroupWidget class constructor.
+     * \param[in] name group name.
+     * \param[in] parent raw pointer of the widget parent of this one.
+     *
+     */
+    explicit AlarmGroupWidget(const QString &name, QWidget *parent = nullptr);
+
+    /** \brief AlarmGroupWidget class virtual destructor.
+     *
+     */
+    virtual ~AlarmGroupWidget()
+    {};
+
+    /** \brief Returns the name of the group.
+     *
+     */
+    const QString name() const
+    { return m_name; }
+
+    /** \brief Adds an alarm to the group.
+     * \param[in] widget alarm widget.
+     *
+     */
+    void addAlarm(AlarmWidget *widget);
+
+    /** \brief Removes an alarm from the group. The widget is not deleted.
+     * \param[in] widget alarm widget.
+     *
+     */
+    void removeAlarm(AlarmWidget *widget);
+
+    /** \brief Returns true if the alarm belongs to the group.
+     * \param[in] widget alarm widget.
+     *
+     */
+    bool contains(AlarmWidget *widget) const
+    { return m_progress.contains(widget); }
+
+    /** \brief Returns the alarms of the group.
+     *
+     */
+    QList<AlarmWidget *> alarms() const
+    { return m_alarms; }
+
+    /** \brief Returns the number of alarms in the group.
+     *
+     */
+    int count() const
+    { return m_alarms.size(); }
+
+    /** \brief Collapses or expands the group.
+     * \param[in] value true to collapse and false to expand.
+     *
+     */
+    void setCollapsed(bool value);
+
+    /** \brief Returns true if the group is collapsed.
+     *
+     */
+    bool isCollapsed() const
+    { return m_collapsed; }
+
+    /** \brief Sets the aggregation of the progress values.
+     * \param[in] aggregate aggregate type.
+     *
+     */
+    void setAggregate(const Aggregate aggregate);
+
+    /** \brief Returns the aggregation of the progress values.
+     *
+     */
+    Aggregate aggregate() const
+    { return m_aggregate; }
+
+  signals:
+    void collapsedChanged(bool value);
+    void startGroup();
+    void pauseGroup();
+    void stopGroup();
+    void deleteGroup();
+
+  protected:
+    virtual void contextMenuEvent(QContextMenuEvent *e) override;
+
+  private slots:
+    /** \brief Updates the aggregated values with the new progress of the sender alarm.
+     * \param[in] value progress value in [0.0-100.0].
+     *
+     */
+    void onAlarmProgress(double value);
+
+    /** \brief Updates the deadline of the sender alarm.
+     *
+     */
+    void onAlarmStateChanged();
+
+    /** \brief Collapses or expands the group when the header button is pressed.
+     *
+     */
+    void onCollapsePressed();
+
+  private:
+    /** \brief Updates the progress value of the alarm in the aggregation structures.
+     * \param[in] widget alarm widget.
+     * \param[in] value new progress value.
+     *
+     */
+    void setProgress(AlarmWidget *widget, double value);
+
+    /** \brief Updates the deadline of the alarm in the aggregation structures.
+     * \param[in] widget alarm widget.
+     *
+     */
+    void setDeadline(AlarmWidget *widget);
+
+    /** \brief Updates the header with the current aggregated values.
+     *
+     */
+    void updateHeader();
+
+    QString                       m_name;      /** group name.                                                   */
+    bool                          m_collapsed; /** true if collapsed.                                            */
+    Aggregate                     m_aggregate; /** progress aggregation.                                         */
+    QList<AlarmWidget *>          m_alarms;    /** group members in insertion order.                             */
+    QHash<AlarmWidget *, double>  m_progress;  /** last progress value of each member.                           */
+    QMap<double, int>             m_values;    /** ordered progress values with their multiplicity (min & max).  */
+    double                        m_sum;       /** sum of the progress values (mean).                            */
+    QHash<AlarmWidget *, qint64>  m_deadline;  /** deadline in msecs since epoch of each running member.         */
+    QMap<qint64, int>             m_deadlines; /** ordered deadlines of running members with their multiplicity. */
+    QString                       m_summary;   /** last header text, to avoid needless updates.                  */
+    int                           m_shown;     /** last header progress in per-mille, to avoid needless repaints. */
+
+    DrawFrame   *m_header;        /** group header.                   */
+    QToolButton *m_collapse;      /** collapse/expand button.         */
+    QLabel      *m_title;         /** group name label.               */
+    QLabel      *m_summaryLabel;  /** aggregated values label.        */
+    QWidget     *m_members;       /** container of the member alarms. */
+    QVBoxLayout *m_membersLayout; /** members layout.                 */
+};
+
+#endif // ALARMGROUPWIDGET_H_
@@ -0,0 +1,201 @@
+/*
+ File: AlarmJournal.cpp
+ Created on: 19/10/2026
+ Author: Felix de las Pozas Alvarez
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Project
+#include <AlarmJournal.h>
+#include <AlarmStore.h>
+
+// Qt
+#include <QDataStream>
+#include <QDebug>
+
+// Record layout: [quint32 payload size][quint16 payload checksum][payload]
+const qint64 RECORD_HEADER_SIZE = sizeof(quint32) + sizeof(quint16);
+const quint32 MAX_RECORD_SIZE   = 1024*1024;
+
+//-----------------------------------------------------------------
+AlarmJournal::AlarmJournal(const QString &path)
+: m_file{path}
+{
+  // drop a record torn by a crash, or the new records would be appended after it and never replayed.
+  QList<Entry> entries;
+  const auto valid = parse(path, entries);
+  if(m_file.exists() && valid < m_file.size())
+    m_file.resize(valid);
+
+  open();
+}
+
+//-----------------------------------------------------------------
+AlarmJournal::~AlarmJournal()
+{
+  m_file.close();
+}
+
+//-----------------------------------------------------------------
+bool AlarmJournal::open()
+{
+  if(!m_file.open(QIODevice::WriteOnly|QIODevice::Append))
+  {
+    qWarning() << "Unable to open alarms journal" << m_file.fileName() << m_file.errorString();
+    return false;
+  }
+
+  return true;
+}
+
+//-----------------------------------------------------------------
+bool AlarmJournal::append(const Entry &entry)
+{
+  return append(QList<Entry>{entry});
+}
+
+//-----------------------------------------------------------------
+bool AlarmJournal::append(const QList<Entry> &entries)
+{
+  if(entries.isEmpty()) return true;
+  if(!m_file.isOpen() && !open()) return false;
+
+  QByteArray records;
+  for(const auto &entry: entries)
+    records.append(record(entry));
+
+  // a single write call for all the records, flushed to the OS so a crash or kill doesn't lose them.
+  if(m_file.write(records) != records.size() || !m_file.flush())
+  {
+    qWarning() << "Unable to write to alarms journal" << m_file.fileName() << m_file.errorString();
+    return false;
+  }
+
+  return true;
+}
+
+//-----------------------------------------------------------------
+QByteArray AlarmJournal::record(const Entry &entry)
+{
+  QByteArray payload;
+  {
+    QDataStream stream(&payload, QIODevice::WriteOnly);
+    stream.setVersion(QDataStream::Qt_6_0);
+    stream << static_cast<quint8>(entry.operation) << entry.name;
+
+    if(entry.operation != Operation::REMOVE)
+      stream << entry.configuration;
+  }
+
+  QByteArray result;
+  {
+    QDataStream stream(&result, QIODevice::WriteOnly);
+    stream << static_cast<quint32>(payload.size()) << qChecksum(payload);
+  }
+  result.append(payload);
+
+  return result;
+}
+
+//-----------------------------------------------------------------
+void AlarmJournal::clear()
+{
+  if(!m_file.isOpen() && !open()) return;
+
+  if(!m_file.resize(0))
+    qWarning() << "Unable to clear alarms journal" << m_file.fileName() << m_file.errorString();
+}
+
+//-----------------------------------------------------------------
+QList<AlarmJournal::Entry> AlarmJournal::read(const QString &path)
+{
+  QList<Entry> result;
+  parse(path, result);
+
+  return result;
+}
+
+//-----------------------------------------------------------------
+qint64 AlarmJournal::parse(const QString &path, QList<Entry> &result)
+{
+  QFile file(path);
+  if(!file.exists() || !file.open(QIODevice::ReadOnly)) return 0;
+
+  const auto data = file.readAll();
+  file.close();
+
+  qint64 position = 0;
+  while(position + RECORD_HEADER_SIZE <= data.size())
+  {
+    quint32 size;
+    quint16 checksum;
+    {
+      QDataStream stream(data.mid(position, RECORD_HEADER_SIZE));
+      stream >> size >> checksum;
+    }
+
+    if(size > MAX_RECORD_SIZE || position + RECORD_HEADER_SIZE + size > data.size()) break;
+
+    const auto payload = data.mid(position + RECORD_HEADER_SIZE, size);
+    if(qChecksum(payload) != checksum) break;
+
+    QDataStream stream(payload);
+    stream.setVersion(QDataStream::Qt_6_0);
+
+    quint8 operation;
+    Entry entry;
+    stream >> operation >> entry.name;
+    entry.operation = static_cast<Operation>(operation);
+
+    if(entry.operation != Operation::REMOVE)
+      stream >> entry.configuration;
+
+    if(stream.status() != QDataStream::Ok) break;
+
+    result << entry;
+    position += RECORD_HEADER_SIZE + size;
+  }
+
+  if(position != data.size())
+    qWarning() << "Alarms journal" << path << "truncated at" << position << "of" << data.size() << "bytes.";
+
+  return position;
+}
+
+//-----------------------------------------------------------------
+void AlarmJournal::apply(const QList<Entry> &entries, QMap<QString, AlarmConfiguration> &alarms)
+{
+  for(const auto &entry: entries)
+  {
+    switch(entry.operation)
+    {
+      case Operation::MODIFY:
+        alarms.remove(entry.name);
+        [[fallthrough]];
+      case Operation::CREATE:
+        alarms.insert(entry.configuration.name, entry.configuration);
+        break;
+      case Operation::REMOVE:
+        alarms.remove(entry.name);
+        break;
+      case Operation::STATE:
+        if(alarms.contains(entry.name))
+          alarms[entry.name].state = entry.configuration.state;
+        break;
+      default:
+        break;
+    }
+  }
+}
@@ -0,0 +1,127 @@
+/*
+ File: AlarmJournal.h
+ Created on: 19/10/2026
+ Author: Felix de las Pozas Alvarez
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ALARMJOURNAL_H_
+#define ALARMJOURNAL_H_
+
+// Project
+#include <AlarmConfiguration.h>
+
+// Qt
+#include <QFile>
+#include <QList>
+#include <QMap>
+
+/** \class AlarmJournal
+ * \brief Append-only log of the alarm changes. Every change is written as a checksummed record
+ *        when it happens, the journal is replayed on startup and cleared once its changes have been
+ *        compacted into the store.
+ *
+ */
+class AlarmJournal
+{
+  public:
+    /** \brief Journal operations.
+     *
+     */
+    enum class Operation: quint8 { CREATE = 1, MODIFY, REMOVE, STATE };
+
+    /** \struct Entry
+     * \brief Journal record.
+     *
+     */
+    struct Entry
+    {
+      Operation          operation;     /** operation.                                                     */
+      QString            name;          /** alarm name, the previous name of the alarm for modifications. */
+      AlarmConfiguration configuration; /** alarm configuration, empty for removals, only the state is used *
+                                          * for state changes.                                              */
+    };
+
+    /** \brief AlarmJournal class constructor.
+     * \param[in] path journal file path.
+     *
+     */
+    explicit AlarmJournal(const QString &path);
+
+    /** \brief AlarmJournal class destructor.
+     *
+     */
+    ~AlarmJournal();
+
+    /** \brief Appends an entry to the journal. Returns true on success and false otherwise.
+     * \param[in] entry journal entry.
+     *
+     */
+    bool append(const Entry &entry);
+
+    /** \brief Appends the entries to the journal with a single write. Returns true on success and false otherwise.
+     * \param[in] entries journal entries.
+     *
+     */
+    bool append(const QList<Entry> &entries);
+
+    /** \brief Removes all the entries of the journal.
+     *
+     */
+    void clear();
+
+    /** \brief Returns the size of the journal in bytes.
+     *
+     */
+    qint64 size() const
+    { return m_file.size(); }
+
+    /** \brief Returns the valid entries of the given journal file. Reading stops at the first
+     *         truncated or corrupted record.
+     * \param[in] path journal file path.
+     *
+     */
+    static QList<Entry> read(const QString &path);
+
+    /** \brief Applies the entries to the given alarm configurations.
+     * \param[in] entries journal entries.
+     * \param[inout] alarms alarm configurations indexed by name.
+     *
+     */
+    static void apply(const QList<Entry> &entries, QMap<QString, AlarmConfiguration> &alarms);
+
+  private:
+    /** \brief Opens the journal file for appending.
+     *
+     */
+    bool open();
+
+    /** \brief Returns the journal record of the entry, the payload preceded by its size and checksum.
+     * \param[in] entry journal entry.
+     *
+     */
+    static QByteArray record(const Entry &entry);
+
+    /** \brief Reads the valid entries of the given journal file and returns the size in bytes of the valid part.
+     * \param[in] path journal file path.
+     * \param[out] entries valid journal entries.
+     *
+     */
+    static qint64 parse(const QString &path, QList<Entry> &entries);
+
+    QFile m_file; /** journal file. */
+};
+
+#endif // ALARMJOURNAL_H_
@@ -0,0 +1,324 @@
+/*
+ File: AlarmJson.cpp
+ Created on: 19/10/2026
+ Author: Felix de las Pozas Alvarez
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Project
+#include <AlarmJson.h>
+#include <SoundBank.h>
+#include <Utils.h>
+
+// Qt
+#include <QIODevice>
+#include <QJsonDocument>
+#include <QJsonArray>
+#include <QObject>
+
+const QString JSON_NAME       = "name";
+const QString JSON_MESSAGE    = "message";
+const QString JSON_COLOR      = "color";
+const QString JSON_GROUP      = "group";
+const QString JSON_TIMER      = "timer";
+const QString JSON_TIMER_TIME = "time";
+const QString JSON_LOOPS      = "loops";
+const QString JSON_CLOCK      = "clock";
+const QString JSON_SOUND      = "sound";
+const QString JSON_SOUND_FILE = "soundFile";
+const QString JSON_VOLUME     = "volume";
+const QString JSON_TRAY       = "tray";
+const QString JSON_DESKTOP    = "desktop";
+const QString JSON_KEYBOARD   = "keyboard";
+const QString JSON_POSITION   = "position";
+const QString JSON_OPACITY    = "opacity";
+
+const QString TIME_FORMAT = "hh:mm:ss";
+
+const qint64 CHUNK_SIZE = 64*1024;  // bytes read from the device at once.
+
+//-----------------------------------------------------------------
+QJsonObject AlarmJson::toJson(const AlarmConfiguration &conf)
+{
+  QJsonObject object;
+  object.insert(JSON_NAME, conf.name);
+  object.insert(JSON_MESSAGE, conf.message);
+  object.insert(JSON_COLOR, conf.color);
+  if(!conf.group.isEmpty())
+    object.insert(JSON_GROUP, conf.group);
+  object.insert(JSON_TIMER, conf.isTimer);
+
+  if(conf.isTimer)
+  {
+    object.insert(JSON_TIMER_TIME, conf.timerTime.toString(TIME_FORMAT));
+    object.insert(JSON_LOOPS, conf.timerLoops);
+  }
+  else
+  {
+    object.insert(JSON_CLOCK, conf.clockDateTime.toString(Qt::ISODate));
+  }
+
+  object.insert(JSON_SOUND, conf.sound);
+  if(!conf.soundFile.isEmpty())
+    object.insert(JSON_SOUND_FILE, conf.soundFile);
+  object.insert(JSON_VOLUME, conf.soundVolume);
+  object.insert(JSON_TRAY, conf.useTray);
+  object.insert(JSON_DESKTOP, conf.useDesktopWidget);
+  object.insert(JSON_KEYBOARD, conf.useLogiled);
+  object.insert(JSON_POSITION, QJsonArray{conf.widgetPosition.x(), conf.widgetPosition.y()});
+  object.insert(JSON_OPACITY, conf.widgetOpacity);
+
+  return object;
+}
+
+//-----------------------------------------------------------------
+bool AlarmJson::fromJson(const QJsonObject &object, AlarmConfiguration &conf, QString &error)
+{
+  auto hasType = [&object, &error](const QString &key, QJsonValue::Type type)
+  {
+    if(object.contains(key) && object.value(key).type() != type)
+    {
+      error = QObject::tr("invalid type of '%1'").arg(key);
+      return false;
+    }
+
+    return true;
+  };
+
+  auto inRange = [&object, &error](const QString &key, int minimum, int maximum, int defaultValue, int &value)
+  {
+    value = object.value(key).toInt(defaultValue);
+    if(value < minimum || value > maximum)
+    {
+      error = QObject::tr("'%1' must be in [%2,%3]").arg(key).arg(minimum).arg(maximum);
+      return false;
+    }
+
+    return true;
+  };
+
+  conf = AlarmConfiguration();
+
+  for(const auto &key: {JSON_NAME, JSON_MESSAGE, JSON_COLOR, JSON_GROUP, JSON_TIMER_TIME, JSON_CLOCK, JSON_SOUND_FILE})
+    if(!hasType(key, QJsonValue::String)) return false;
+
+  for(const auto &key: {JSON_TIMER, JSON_LOOPS, JSON_TRAY, JSON_DESKTOP, JSON_KEYBOARD})
+    if(!hasType(key, QJsonValue::Bool)) return false;
+
+  for(const auto &key: {JSON_SOUND, JSON_VOLUME, JSON_OPACITY})
+    if(!hasType(key, QJsonValue::Double)) return false;
+
+  if(!hasType(JSON_POSITION, QJsonValue::Array)) return false;
+
+  conf.name = object.value(JSON_NAME).toString().trimmed();
+  if(conf.name.isEmpty())
+  {
+    error = QObject::tr("missing alarm name");
+    return false;
+  }
+
+  conf.message = object.value(JSON_MESSAGE).toString();
+  conf.group   = object.value(JSON_GROUP).toString().trimmed();
+  conf.color   = object.value(JSON_COLOR).toString().toLower();
+
+  if(!Utils::isColorName(conf.color))
+  {
+    error = QObject::tr("invalid color '%1'").arg(conf.color);
+    return false;
+  }
+
+  conf.isTimer = object.value(JSON_TIMER).toBool(false);
+  if(conf.isTimer)
+  {
+    conf.timerTime  = QTime::fromString(object.value(JSON_TIMER_TIME).toString(), TIME_FORMAT);
+    conf.timerLoops = object.value(JSON_LOOPS).toBool(false);
+
+    if(!conf.timerTime.isValid() || conf.timerTime.msecsSinceStartOfDay() == 0)
+    {
+      error = QObject::tr("invalid timer time, must be '%1'").arg(TIME_FORMAT);
+      return false;
+    }
+  }
+  else
+  {
+    conf.clockDateTime = QDateTime::fromString(object.value(JSON_CLOCK).toString(), Qt::ISODate);
+
+    if(!conf.clockDateTime.isValid())
+    {
+      error = QObject::tr("invalid clock date and time, must be ISO 8601");
+      return false;
+    }
+  }
+
+  if(!inRange(JSON_SOUND, 0, SoundBank::count() - 1, 0, conf.sound) ||
+     !inRange(JSON_VOLUME, 0, 100, 100, conf.soundVolume) ||
+     !inRange(JSON_OPACITY, 0, 100, 60, conf.widgetOpacity))
+    return false;
+
+  // a missing file is not an error, the alarm rings its sound instead.
+  conf.soundFile        = object.value(JSON_SOUND_FILE).toString();
+  conf.useTray          = object.value(JSON_TRAY).toBool(false);
+  conf.useDesktopWidget = object.value(JSON_DESKTOP).toBool(false);
+  conf.useLogiled       = object.value(JSON_KEYBOARD).toBool(false);
+
+  if(object.contains(JSON_POSITION))
+  {
+    const auto position = object.value(JSON_POSITION).toArray();
+    if(position.size() != 2 || !position.at(0).isDouble() || !position.at(1).isDouble())
+    {
+      error = QObject::tr("'%1' must be an array of two numbers").arg(JSON_POSITION);
+      return false;
+    }
+
+    conf.widgetPosition = QPoint{position.at(0).toInt(), position.at(1).toInt()};
+  }
+
+  return true;
+}
+
+//-----------------------------------------------------------------
+AlarmJson::Reader::Reader(QIODevice *device)
+: m_device  {device}
+, m_position{0}
+, m_offset  {0}
+, m_array   {false}
+, m_finished{false}
+, m_count   {0}
+{
+}
+
+//-----------------------------------------------------------------
+bool AlarmJson::Reader::fill()
+{
+  const auto data = m_device->read(CHUNK_SIZE);
+  if(data.isEmpty()) return false;
+
+  m_buffer.append(data);
+  return true;
+}
+
+//-----------------------------------------------------------------
+bool AlarmJson::Reader::next(QJsonObject &object)
+{
+  if(m_finished || !m_error.isEmpty()) return false;
+
+  // only the data of the current object is kept.
+  m_offset += m_position;
+  m_buffer.remove(0, m_position);
+  m_position = 0;
+
+  // start of the next object.
+  while(true)
+  {
+    if(m_position >= m_buffer.size() && !fill())
+    {
+      if(m_array) m_error = QObject::tr("unterminated array at offset %1").arg(m_offset + m_position);
+      m_finished = true;
+      return false;
+    }
+
+    const char c = m_buffer.at(m_position);
+    if(c == '{') break;
+
+    ++m_position;
+
+    if(c == ' ' || c == '\t' || c == '\n' || c == '\r') continue;
+    if(c == ',' && m_array && m_count > 0) continue;
+    if(c == '[' && !m_array && m_count == 0)
+    {
+      m_array = true;
+      continue;
+    }
+    if(c == ']' && m_array)
+    {
+      m_finished = true;
+      return false;
+    }
+
+    m_error = QObject::tr("unexpected character '%1' at offset %2").arg(QChar(c)).arg(m_offset + m_position - 1);
+    return false;
+  }
+
+  // end of the object, skipping the braces inside strings.
+  const auto start = m_position;
+  auto end = start;
+  int depth = 0;
+  bool inString = false;
+  bool escaped = false;
+
+  while(true)
+  {
+    if(end >= m_buffer.size() && !fill())
+    {
+      m_error = QObject::tr("unterminated object at offset %1").arg(m_offset + start);
+      return false;
+    }
+
+    const char c = m_buffer.at(end++);
+
+    if(inString)
+    {
+      if(escaped)        escaped = false;
+      else if(c == '\\') escaped = true;
+      else if(c == '"')  inString = false;
+      continue;
+    }
+
+    if(c == '"') inString = true;
+    else if(c == '{' || c == '[') ++depth;
+    else if((c == '}' || c == ']') && --depth == 0) break;
+  }
+
+  m_position = end;
+
+  QJsonParseError parseError;
+  const auto document = QJsonDocument::fromJson(QByteArray::fromRawData(m_buffer.constData() + start, end - start), &parseError);
+
+  if(parseError.error != QJsonParseError::NoError)
+  {
+    m_error = QObject::tr("%1 at offset %2").arg(parseError.errorString()).arg(m_offset + start + parseError.offset);
+    return false;
+  }
+
+  object = document.object();
+  ++m_count;
+
+  return true;
+}
+
+//-----------------------------------------------------------------
+AlarmJson::Writer::Writer(QIODevice *device)
+: m_device{device}
+, m_first {true}
+{
+}
+
+//-----------------------------------------------------------------
+bool AlarmJson::Writer::write(const AlarmConfiguration &conf)
+{
+  QByteArray data = m_first ? "[\n" : ",\n";
+  data += QJsonDocument(toJson(conf)).toJson(QJsonDocument::Compact);
+  m_first = false;
+
+  return m_device->write(data) == data.size();
+}
+
+//-----------------------------------------------------------------
+bool AlarmJson::Writer::finish()
+{
+  const QByteArray data = m_first ? "[]\n" : "\n]\n";
+
+  return m_device->write(data) == data.size();
+}
@@ -0,0 +1,124 @@
+/*
+ File: AlarmJson.h
+ Created on: 19/10/2026
+ Author: Felix de las Pozas Alvarez
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ALARMJSON_H_
+#define ALARMJSON_H_
+
+// Project
+#include <AlarmConfiguration.h>
+
+// Qt
+#include <QJsonObject>
+#include <QByteArray>
+
+class QIODevice;
+
+/** JSON alarm files are an array of alarm objects, one per line when written by the application.
+ *  A sequence of objects without the enclosing array (JSON lines) is also accepted when reading.
+ *
+ */
+namespace AlarmJson
+{
+  /** \brief Returns the JSON object of the alarm. The run state is not exported.
+   * \param[in] conf alarm configuration.
+   *
+   */
+  QJsonObject toJson(const AlarmConfiguration &conf);
+
+  /** \brief Converts the JSON object to an alarm configuration. Returns true if the object is a valid
+   *         alarm and false otherwise.
+   * \param[in] object JSON object.
+   * \param[out] conf alarm configuration.
+   * \param[out] error error message if the object is not valid.
+   *
+   */
+  bool fromJson(const QJsonObject &object, AlarmConfiguration &conf, QString &error);
+
+  /** \class Reader
+   * \brief Reads the alarm objects of a JSON file one at a time, only the current object is parsed.
+   *
+   */
+  class Reader
+  {
+    public:
+      /** \brief Reader class constructor.
+       * \param[in] device open device to read from.
+       *
+       */
+      explicit Reader(QIODevice *device);
+
+      /** \brief Reads the next object. Returns false at the end of the file or on a syntax error.
+       * \param[out] object next JSON object.
+       *
+       */
+      bool next(QJsonObject &object);
+
+      /** \brief Returns the syntax error message or an empty string if there were no errors.
+       *
+       */
+      const QString error() const
+      { return m_error; }
+
+    private:
+      /** \brief Appends the next chunk of the device to the buffer. Returns false if there is no more data.
+       *
+       */
+      bool fill();
+
+      QIODevice  *m_device;   /** device to read from.                       */
+      QByteArray  m_buffer;   /** unread data.                               */
+      qsizetype   m_position; /** position of the next character in buffer. */
+      qint64      m_offset;   /** device offset of the buffer start.         */
+      bool        m_array;    /** true if the objects are in an array.       */
+      bool        m_finished; /** true after the end of the objects.         */
+      int         m_count;    /** number of objects read.                    */
+      QString     m_error;    /** syntax error message.                      */
+  };
+
+  /** \class Writer
+   * \brief Writes the alarms to a JSON file one at a time.
+   *
+   */
+  class Writer
+  {
+    public:
+      /** \brief Writer class constructor.
+       * \param[in] device open device to write to.
+       *
+       */
+      explicit Writer(QIODevice *device);
+
+      /** \brief Writes the alarm. Returns true on success and false otherwise.
+       * \param[in] conf alarm configuration.
+       *
+       */
+      bool write(const AlarmConfiguration &conf);
+
+      /** \brief Closes the array of alarms. Returns true on success and false otherwise.
+       *
+       */
+      bool finish();
+
+    private:
+      QIODevice *m_device; /** device to write to.                */
+      bool       m_first;  /** true if no alarm has been written. */
+  };
+}
+
+#endif // ALARMJSON_H_
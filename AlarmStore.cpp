@@ -0,0 +1,437 @@
+/*
+ File: AlarmStore.cpp
+ Created on: 19/10/2026
+ Author: Felix de las Pozas Alvarez
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Project
+#include <AlarmStore.h>
+
+// Qt
+#include <QSettings>
+#include <QDataStream>
+#include <QFile>
+#include <QSaveFile>
+#include <QHash>
+#include <QDebug>
+
+// C++
+#include <cstring>
+
+const QString ALARMS = "Alarms";
+
+const QString ALARM_STORE    = "AlarmStore";
+const QString BINARY_STORE   = "Binary";
+const QString SETTINGS_STORE = "Settings";
+
+const QString ALARM_MESSAGE         = "Message";
+const QString ALARM_COLOR           = "Color";
+const QString ALARM_GROUP           = "Group";
+const QString ALARM_IS_TIMER        = "Timer";
+const QString ALARM_TIMER_LOOP      = "Loops";
+const QString ALARM_TIMER_TIME      = "TimerTime";
+const QString ALARM_CLOCK_DATETIME  = "ClockDateTime";
+const QString ALARM_SOUND           = "Sound";
+const QString ALARM_SOUND_FILE      = "SoundFile";
+const QString ALARM_SOUND_VOLUME    = "SoundVolume";
+const QString ALARM_USE_TRAY        = "UseTray";
+const QString ALARM_USE_DESKTOP     = "UseDesktop";
+const QString ALARM_USE_LOGILED     = "UseLogiled";
+const QString ALARM_WIDGET_POSITION = "DesktopWidgetPosition";
+const QString ALARM_WIDGET_OPACITY  = "DesktopWidgetOpacity";
+const QString ALARM_STATE           = "State";
+const QString ALARM_STATE_DEADLINE  = "Deadline";
+const QString ALARM_STATE_REMAINING = "Remaining";
+
+// Binary store layout, native byte order: [Header][Record x count][UTF-16 string table]
+// Version 1.
+namespace
+{
+  constexpr quint32 BINARY_MAGIC   = 0x53414C4D; // "MLAS" in little endian.
+  constexpr quint16 BINARY_VERSION = 1;
+
+  enum Flags: quint16 { IS_TIMER = 1, LOOPS = 2, USE_TRAY = 4, USE_DESKTOP = 8, USE_LOGILED = 16, HAS_CLOCK = 32 };
+
+  struct Header
+  {
+    quint32 magic;         /** file identifier, also detects byte order. */
+    quint16 version;       /** format version.                           */
+    quint16 recordSize;    /** size of a record in bytes.                */
+    quint32 count;         /** number of records.                        */
+    quint32 stringsOffset; /** offset of the string table in bytes.      */
+    quint32 stringsSize;   /** size of the string table in UTF-16 units. */
+    quint32 reserved[3];   /** unused, zero.                             */
+  };
+
+  struct Record
+  {
+    qint64  clockDateTime; /** clock alarm time in msecs since epoch.                 */
+    qint64  deadline;      /** run state deadline in msecs since epoch.               */
+    qint64  remaining;     /** run state remaining seconds.                           */
+    quint32 name;          /** strings as offset and length in the string table.      */
+    quint32 nameLength;
+    quint32 message;
+    quint32 messageLength;
+    quint32 color;
+    quint32 colorLength;
+    quint32 group;
+    quint32 groupLength;
+    qint32  timerTime;     /** timer duration in msecs.                               */
+    qint32  positionX;     /** desktop widget position.                               */
+    qint32  positionY;
+    quint16 flags;         /** Flags values.                                          */
+    quint8  sound;         /** sound index.                                           */
+    quint8  soundVolume;   /** volume in [0,100].                                     */
+    quint8  opacity;       /** widget opacity in [0,100].                             */
+    quint8  status;        /** run state status.                                      */
+    quint8  reserved[4];   /** unused, zero.                                          */
+    quint32 soundFile;     /** user sound file in the string table.                   */
+    quint32 soundFileLength;
+  };
+
+  static_assert(sizeof(Header) == 32, "Unexpected binary store header size.");
+  static_assert(sizeof(Record) == 88, "Unexpected binary store record size.");
+}
+
+//-----------------------------------------------------------------
+void AlarmStore::writeAlarm(QSettings &settings, const AlarmConfiguration &conf)
+{
+  settings.beginGroup(ALARMS);
+  settings.remove(conf.name);
+  settings.beginGroup(conf.name);
+
+  settings.setValue(ALARM_MESSAGE, conf.message);
+  settings.setValue(ALARM_COLOR, conf.color);
+  settings.setValue(ALARM_GROUP, conf.group);
+  settings.setValue(ALARM_IS_TIMER, conf.isTimer);
+
+  if(conf.isTimer)
+  {
+    settings.setValue(ALARM_TIMER_LOOP, conf.timerLoops);
+    settings.setValue(ALARM_TIMER_TIME, conf.timerTime);
+  }
+  else
+    settings.setValue(ALARM_CLOCK_DATETIME, conf.clockDateTime);
+
+  settings.setValue(ALARM_SOUND, conf.sound);
+  if(!conf.soundFile.isEmpty())
+    settings.setValue(ALARM_SOUND_FILE, conf.soundFile);
+  settings.setValue(ALARM_SOUND_VOLUME, conf.soundVolume);
+  settings.setValue(ALARM_USE_TRAY, conf.useTray);
+  settings.setValue(ALARM_USE_DESKTOP, conf.useDesktopWidget);
+  settings.setValue(ALARM_USE_LOGILED, conf.useLogiled);
+  settings.setValue(ALARM_WIDGET_POSITION, conf.widgetPosition);
+  settings.setValue(ALARM_WIDGET_OPACITY, conf.widgetOpacity);
+
+  settings.endGroup();
+  settings.endGroup();
+
+  writeState(settings, conf.name, conf.state);
+}
+
+//-----------------------------------------------------------------
+void AlarmStore::writeState(QSettings &settings, const QString &name, const AlarmState &state)
+{
+  settings.beginGroup(ALARMS);
+  settings.beginGroup(name);
+
+  settings.setValue(ALARM_STATE, static_cast<int>(state.status));
+  settings.setValue(ALARM_STATE_DEADLINE, state.deadline);
+  settings.setValue(ALARM_STATE_REMAINING, state.remaining);
+
+  settings.endGroup();
+  settings.endGroup();
+}
+
+//-----------------------------------------------------------------
+void AlarmStore::removeAlarm(QSettings &settings, const QString &name)
+{
+  settings.beginGroup(ALARMS);
+  settings.remove(name);
+  settings.endGroup();
+}
+
+//-----------------------------------------------------------------
+QList<AlarmConfiguration> AlarmStore::readAlarms(QSettings &settings)
+{
+  QList<AlarmConfiguration> result;
+
+  settings.beginGroup(ALARMS);
+  auto alarmIds = settings.childGroups();
+  alarmIds.sort();
+
+  for(const auto &name: alarmIds)
+  {
+    settings.beginGroup(name);
+
+    AlarmConfiguration conf;
+    conf.name    = name;
+    conf.message = settings.value(ALARM_MESSAGE, QString()).toString();
+    conf.color   = settings.value(ALARM_COLOR, QString("white")).toString();
+    conf.group   = settings.value(ALARM_GROUP, QString()).toString();
+    conf.isTimer = settings.value(ALARM_IS_TIMER, false).toBool();
+
+    if(conf.isTimer)
+    {
+      conf.timerTime  = settings.value(ALARM_TIMER_TIME, QTime(0,1,0)).toTime();
+      conf.timerLoops = settings.value(ALARM_TIMER_LOOP, false).toBool();
+    }
+    else
+      conf.clockDateTime = settings.value(ALARM_CLOCK_DATETIME, QDateTime()).toDateTime();
+
+    conf.sound            = settings.value(ALARM_SOUND, 0).toInt();
+    conf.soundFile        = settings.value(ALARM_SOUND_FILE, QString()).toString();
+    conf.soundVolume      = settings.value(ALARM_SOUND_VOLUME, 100).toInt();
+    conf.useTray          = settings.value(ALARM_USE_TRAY, false).toBool();
+    conf.useDesktopWidget = settings.value(ALARM_USE_DESKTOP, false).toBool();
+    conf.useLogiled       = settings.value(ALARM_USE_LOGILED, false).toBool();
+    conf.widgetPosition   = settings.value(ALARM_WIDGET_POSITION, QPoint{0,0}).toPoint();
+    conf.widgetOpacity    = settings.value(ALARM_WIDGET_OPACITY, 60).toInt();
+
+    conf.state.status    = static_cast<AlarmState::Status>(settings.value(ALARM_STATE, 0).toInt());
+    conf.state.deadline  = settings.value(ALARM_STATE_DEADLINE, 0).toLongLong();
+    conf.state.remaining = settings.value(ALARM_STATE_REMAINING, 0).toLongLong();
+
+    settings.endGroup();
+
+    result << conf;
+  }
+
+  settings.endGroup();
+
+  return result;
+}
+
+//-----------------------------------------------------------------
+void AlarmStore::writeAlarms(QSettings &settings, const QList<AlarmConfiguration> &alarms)
+{
+  for(const auto &conf: alarms)
+    writeAlarm(settings, conf);
+}
+
+//-----------------------------------------------------------------
+void AlarmStore::clearAlarms(QSettings &settings)
+{
+  settings.remove(ALARMS);
+}
+
+//-----------------------------------------------------------------
+bool AlarmStore::usesBinaryStore(QSettings &settings)
+{
+  return settings.value(ALARM_STORE, SETTINGS_STORE).toString() == BINARY_STORE;
+}
+
+//-----------------------------------------------------------------
+void AlarmStore::setUsesBinaryStore(QSettings &settings, bool value)
+{
+  settings.setValue(ALARM_STORE, value ? BINARY_STORE : SETTINGS_STORE);
+}
+
+//-----------------------------------------------------------------
+QList<AlarmConfiguration> AlarmStore::loadBinary(const QString &path, bool *ok)
+{
+  QList<AlarmConfiguration> result;
+  if(ok) *ok = false;
+
+  QFile file(path);
+  if(!file.open(QIODevice::ReadOnly)) return result;
+
+  const auto size = file.size();
+  if(size < static_cast<qint64>(sizeof(Header))) return result;
+
+  const auto data = file.map(0, size);
+  if(!data) return result;
+
+  Header header;
+  std::memcpy(&header, data, sizeof(Header));
+
+  const qint64 recordsEnd = static_cast<qint64>(sizeof(Header)) + static_cast<qint64>(header.count) * static_cast<qint64>(sizeof(Record));
+  const qint64 stringsEnd = static_cast<qint64>(header.stringsOffset) + static_cast<qint64>(header.stringsSize) * static_cast<qint64>(sizeof(char16_t));
+
+  const bool valid = (header.magic == BINARY_MAGIC) && (header.version == BINARY_VERSION) &&
+                     (header.recordSize == sizeof(Record)) && (recordsEnd <= static_cast<qint64>(header.stringsOffset)) &&
+                     (header.stringsOffset % sizeof(char16_t) == 0) && (stringsEnd <= size);
+
+  if(!valid)
+  {
+    qWarning() << "Invalid binary alarm store" << path;
+    file.unmap(data);
+    return result;
+  }
+
+  const auto strings = reinterpret_cast<const QChar *>(data + header.stringsOffset);
+  bool stringsValid = true;
+  auto toString = [&](const quint32 offset, const quint32 length)
+  {
+    if(static_cast<quint64>(offset) + length > header.stringsSize)
+    {
+      stringsValid = false;
+      return QString();
+    }
+
+    return QString(strings + offset, length);
+  };
+
+  result.reserve(header.count);
+
+  for(quint32 i = 0; i < header.count && stringsValid; ++i)
+  {
+    Record record;
+    std::memcpy(&record, data + sizeof(Header) + i * sizeof(Record), sizeof(Record));
+
+    AlarmConfiguration conf;
+    conf.name             = toString(record.name, record.nameLength);
+    conf.message          = toString(record.message, record.messageLength);
+    conf.color            = toString(record.color, record.colorLength);
+    conf.group            = toString(record.group, record.groupLength);
+    conf.isTimer          = record.flags & IS_TIMER;
+    conf.timerLoops       = record.flags & LOOPS;
+    conf.timerTime        = QTime::fromMSecsSinceStartOfDay(record.timerTime);
+    if(record.flags & HAS_CLOCK)
+      conf.clockDateTime  = QDateTime::fromMSecsSinceEpoch(record.clockDateTime);
+    conf.sound            = record.sound;
+    conf.soundFile        = toString(record.soundFile, record.soundFileLength);
+    conf.soundVolume      = record.soundVolume;
+    conf.useTray          = record.flags & USE_TRAY;
+    conf.useDesktopWidget = record.flags & USE_DESKTOP;
+    conf.useLogiled       = record.flags & USE_LOGILED;
+    conf.widgetPosition   = QPoint{record.positionX, record.positionY};
+    conf.widgetOpacity    = record.opacity;
+    conf.state.status     = static_cast<AlarmState::Status>(record.status);
+    conf.state.deadline   = record.deadline;
+    conf.state.remaining  = record.remaining;
+
+    result << conf;
+  }
+
+  file.unmap(data);
+
+  if(!stringsValid)
+  {
+    qWarning() << "Invalid string table in binary alarm store" << path;
+    result.clear();
+    return result;
+  }
+
+  if(ok) *ok = true;
+
+  return result;
+}
+
+//-----------------------------------------------------------------
+bool AlarmStore::saveBinary(const QString &path, const QList<AlarmConfiguration> &alarms)
+{
+  QVector<Record> records;
+  records.reserve(alarms.size());
+
+  QVector<char16_t> strings;
+  QHash<QString, quint32> offsets; // colors, groups and messages are usually repeated.
+
+  auto addString = [&strings, &offsets](const QString &string, quint32 &offset, quint32 &length)
+  {
+    length = string.size();
+
+    auto it = offsets.constFind(string);
+    if(it != offsets.constEnd())
+    {
+      offset = it.value();
+      return;
+    }
+
+    offset = strings.size();
+    offsets.insert(string, offset);
+    strings.resize(offset + string.size());
+    std::memcpy(strings.data() + offset, string.utf16(), string.size() * sizeof(char16_t));
+  };
+
+  for(const auto &conf: alarms)
+  {
+    Record record;
+    std::memset(&record, 0, sizeof(Record));
+
+    addString(conf.name, record.name, record.nameLength);
+    addString(conf.message, record.message, record.messageLength);
+    addString(conf.color, record.color, record.colorLength);
+    addString(conf.group, record.group, record.groupLength);
+    addString(conf.soundFile, record.soundFile, record.soundFileLength);
+
+    record.flags = (conf.isTimer ? IS_TIMER : 0) | (conf.timerLoops ? LOOPS : 0) | (conf.useTray ? USE_TRAY : 0) |
+                   (conf.useDesktopWidget ? USE_DESKTOP : 0) | (conf.useLogiled ? USE_LOGILED : 0) |
+                   (conf.clockDateTime.isValid() ? HAS_CLOCK : 0);
+
+    record.timerTime     = conf.timerTime.isValid() ? conf.timerTime.msecsSinceStartOfDay() : 0;
+    record.clockDateTime = conf.clockDateTime.isValid() ? conf.clockDateTime.toMSecsSinceEpoch() : 0;
+    record.sound         = static_cast<quint8>(conf.sound);
+    record.soundVolume   = static_cast<quint8>(conf.soundVolume);
+    record.opacity       = static_cast<quint8>(conf.widgetOpacity);
+    record.positionX     = conf.widgetPosition.x();
+    record.positionY     = conf.widgetPosition.y();
+    record.status        = static_cast<quint8>(conf.state.status);
+    record.deadline      = conf.state.deadline;
+    record.remaining     = conf.state.remaining;
+
+    records << record;
+  }
+
+  Header header;
+  std::memset(&header, 0, sizeof(Header));
+  header.magic         = BINARY_MAGIC;
+  header.version       = BINARY_VERSION;
+  header.recordSize    = sizeof(Record);
+  header.count         = records.size();
+  header.stringsOffset = sizeof(Header) + records.size() * sizeof(Record);
+  header.stringsSize   = strings.size();
+
+  QSaveFile file(path);
+  if(!file.open(QIODevice::WriteOnly)) return false;
+
+  file.write(reinterpret_cast<const char *>(&header), sizeof(Header));
+  file.write(reinterpret_cast<const char *>(records.constData()), records.size() * sizeof(Record));
+  file.write(reinterpret_cast<const char *>(strings.constData()), strings.size() * sizeof(char16_t));
+
+  return file.commit();
+}
+
+//-----------------------------------------------------------------
+QDataStream &operator<<(QDataStream &stream, const AlarmConfiguration &conf)
+{
+  stream << conf.name << conf.message << conf.color << conf.group << conf.isTimer << conf.timerTime
+         << conf.timerLoops << conf.clockDateTime << static_cast<qint32>(conf.sound) << static_cast<qint32>(conf.soundVolume)
+         << conf.useTray << conf.useDesktopWidget << conf.useLogiled << conf.widgetPosition << static_cast<qint32>(conf.widgetOpacity)
+         << static_cast<quint8>(conf.state.status) << conf.state.deadline << conf.state.remaining
+         << conf.soundFile;
+
+  return stream;
+}
+
+//-----------------------------------------------------------------
+QDataStream &operator>>(QDataStream &stream, AlarmConfiguration &conf)
+{
+  qint32 sound, volume, opacity;
+  quint8 status;
+
+  stream >> conf.name >> conf.message >> conf.color >> conf.group >> conf.isTimer >> conf.timerTime
+         >> conf.timerLoops >> conf.clockDateTime >> sound >> volume
+         >> conf.useTray >> conf.useDesktopWidget >> conf.useLogiled >> conf.widgetPosition >> opacity
+         >> status >> conf.state.deadline >> conf.state.remaining >> conf.soundFile;
+
+  conf.sound         = sound;
+  conf.soundVolume   = volume;
+  conf.widgetOpacity = opacity;
+  conf.state.status  = static_cast<AlarmState::Status>(status);
+
+  return stream;
+}
@@ -0,0 +1,119 @@
+/*
+ File: AlarmStore.h
+ Created on: 19/10/2026
+ Author: Felix de las Pozas Alvarez
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ALARMSTORE_H_
+#define ALARMSTORE_H_
+
+// Project
+#include <AlarmConfiguration.h>
+
+// Qt
+#include <QList>
+
+class QSettings;
+class QDataStream;
+
+namespace AlarmStore
+{
+  /** \brief Writes the alarm to the alarms group of the settings, replacing any previous values.
+   * \param[in] settings settings object.
+   * \param[in] conf alarm configuration.
+   *
+   */
+  void writeAlarm(QSettings &settings, const AlarmConfiguration &conf);
+
+  /** \brief Writes only the run state of the alarm to the alarms group of the settings.
+   * \param[in] settings settings object.
+   * \param[in] name alarm name.
+   * \param[in] state alarm run state.
+   *
+   */
+  void writeState(QSettings &settings, const QString &name, const AlarmState &state);
+
+  /** \brief Removes the alarm from the alarms group of the settings.
+   * \param[in] settings settings object.
+   * \param[in] name alarm name.
+   *
+   */
+  void removeAlarm(QSettings &settings, const QString &name);
+
+  /** \brief Returns the alarms stored in the settings sorted by name.
+   * \param[in] settings settings object.
+   *
+   */
+  QList<AlarmConfiguration> readAlarms(QSettings &settings);
+
+  /** \brief Writes the given alarms to the settings.
+   * \param[in] settings settings object.
+   * \param[in] alarms alarm configurations.
+   *
+   */
+  void writeAlarms(QSettings &settings, const QList<AlarmConfiguration> &alarms);
+
+  /** \brief Removes all the alarms from the settings.
+   * \param[in] settings settings object.
+   *
+   */
+  void clearAlarms(QSettings &settings);
+
+  /** \brief Returns true if the settings select the binary store for the alarms.
+   * \param[in] settings settings object.
+   *
+   */
+  bool usesBinaryStore(QSettings &settings);
+
+  /** \brief Selects the binary store or the settings for the alarms.
+   * \param[in] settings settings object.
+   * \param[in] value true to select the binary store and false to select the settings.
+   *
+   */
+  void setUsesBinaryStore(QSettings &settings, bool value);
+
+  /** \brief Returns the alarms of the binary store file, sorted as they were saved. The file is memory
+   *         mapped and its fixed size records are converted directly, without string parsing.
+   * \param[in] path binary store file path.
+   * \param[out] ok true on success and false if the file doesn't exist, can't be read or is invalid.
+   *
+   */
+  QList<AlarmConfiguration> loadBinary(const QString &path, bool *ok = nullptr);
+
+  /** \brief Saves the alarms to the binary store file, replacing it atomically. Returns true on success
+   *         and false otherwise.
+   * \param[in] path binary store file path.
+   * \param[in] alarms alarm configurations.
+   *
+   */
+  bool saveBinary(const QString &path, const QList<AlarmConfiguration> &alarms);
+}
+
+/** \brief Serializes the alarm configuration.
+ * \param[in] stream data stream.
+ * \param[in] conf alarm configuration.
+ *
+ */
+QDataStream &operator<<(QDataStream &stream, const AlarmConfiguration &conf);
+
+/** \brief Deserializes the alarm configuration.
+ * \param[in] stream data stream.
+ * \param[out] conf alarm configuration.
+ *
+ */
+QDataStream &operator>>(QDataStream &stream, AlarmConfiguration &conf);
+
+#endif // ALARMSTORE_H_
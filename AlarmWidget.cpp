@@ -24,6 +24,8 @@
 #include <MultiAlarm.h>
 #include <NewAlarmDialog.h>
 #include <LogiLED.h>
+#include <SoundBank.h>
+#include <SoundMixer.h>
 #include <Utils.h>
 
 // Qt
@@ -32,33 +34,22 @@
 #include <QPixmap>
 #include <QPainter>
 #include <QMessageBox>
-#include <QSoundEffect>
-#include <QTemporaryFile>
 #include <QMenu>
+#include <QMouseEvent>
 
 const QString COLOR_QSTRING = "<font color='%1'>%2</font>";
 
-const QStringList soundFiles = { ":/MultiAlarm/sounds/Beeper 1.wav",
-                                 ":/MultiAlarm/sounds/Beeper 2.wav",
-                                 ":/MultiAlarm/sounds/Beeper 3.wav",
-                                 ":/MultiAlarm/sounds/Buzzer 1.wav",
-                                 ":/MultiAlarm/sounds/Buzzer 2.wav",
-                                 ":/MultiAlarm/sounds/Code Red.wav",
-                                 ":/MultiAlarm/sounds/Electronic.wav",
-                                 ":/MultiAlarm/sounds/Pager.wav",
-                                 ":/MultiAlarm/sounds/Smoke.wav" };
-
 //-----------------------------------------------------------------
 AlarmWidget::AlarmWidget(MultiAlarm *parent, Qt::WindowFlags flags)
 : QWidget        {parent, flags}
 , m_started      {false}
+, m_selected     {false}
 , m_contrastColor{"black"}
 , m_alarm        {nullptr}
 , m_icon         {nullptr}
 , m_widget       {nullptr}
 , m_logiled      {nullptr}
-, m_sound        {nullptr}
-, m_soundFile    {nullptr}
+, m_sound        {-1}
 , m_parent       {parent}
 {
   setupUi(this);
@@ -83,6 +74,8 @@ AlarmWidget::~AlarmWidget()
 {
   m_alarm = nullptr;
 
+  SoundMixer::getInstance().stop(m_sound);
+
   if(m_icon)
   {
     m_icon->hide();
@@ -130,10 +123,12 @@ void AlarmWidget::start()
     m_widget->show();
 
   if(m_logiled)
-    m_logiled->registerItem(name(), m_alarm->progress(), QColor{color()}, QColor{m_contrastColor});
+    m_logiled->registerItem(name(), m_alarm->progress(), QColor{color()}, QColor{m_contrastColor}, m_configuration.group);
 
   m_alarm->start();
   m_started = true;
+
+  emit stateChanged();
 }
 
 //-----------------------------------------------------------------
@@ -175,7 +170,10 @@ void AlarmWidget::stop()
   setTime(m_alarm->remainingTime());
   
   m_frame->setProgress(0);
-  repaint();
+  update();
+
+  emit progressChanged(0);
+  emit stateChanged();
 }
 
 //-----------------------------------------------------------------
@@ -190,6 +188,98 @@ const QString AlarmWidget::color() const
   return m_configuration.color;
 }
 
+//-----------------------------------------------------------------
+void AlarmWidget::startAlarm()
+{
+  if(!m_started)
+    start();
+  else
+    if(m_configuration.isTimer && !m_alarm->isRunning())
+      onPausePressed();
+}
+
+//-----------------------------------------------------------------
+void AlarmWidget::pauseAlarm()
+{
+  if(m_configuration.isTimer && m_started && m_alarm->isRunning())
+    onPausePressed();
+}
+
+//-----------------------------------------------------------------
+void AlarmWidget::stopAlarm()
+{
+  if(m_configuration.isTimer)
+    onStopPressed();
+}
+
+//-----------------------------------------------------------------
+bool AlarmWidget::isStarted() const
+{
+  return m_started;
+}
+
+//-----------------------------------------------------------------
+bool AlarmWidget::isRunning() const
+{
+  return m_alarm && m_alarm->isRunning();
+}
+
+//-----------------------------------------------------------------
+double AlarmWidget::progress() const
+{
+  return m_alarm ? m_alarm->precisionProgress() : 0.;
+}
+
+//-----------------------------------------------------------------
+QDateTime AlarmWidget::deadline() const
+{
+  if(!isRunning()) return QDateTime();
+
+  return QDateTime::currentDateTime().addSecs(m_alarm->remainingSeconds());
+}
+
+//-----------------------------------------------------------------
+void AlarmWidget::showEvent(QShowEvent *e)
+{
+  if(m_alarm)
+  {
+    setTime(m_alarm->remainingTime());
+    m_frame->setProgress(m_alarm->precisionProgress()/100.);
+  }
+
+  QWidget::showEvent(e);
+}
+
+//-----------------------------------------------------------------
+void AlarmWidget::setSelected(bool value)
+{
+  if(m_selected != value)
+  {
+    m_selected = value;
+    m_frame->setSelected(value);
+    update();
+  }
+}
+
+//-----------------------------------------------------------------
+bool AlarmWidget::isSelected() const
+{
+  return m_selected;
+}
+
+//-----------------------------------------------------------------
+void AlarmWidget::mousePressEvent(QMouseEvent *e)
+{
+  if(e->button() == Qt::LeftButton)
+  {
+    const auto modifiers = e->modifiers();
+    emit selectionRequested(modifiers.testFlag(Qt::ControlModifier) || modifiers.testFlag(Qt::ShiftModifier));
+    e->accept();
+  }
+  else
+    QWidget::mousePressEvent(e);
+}
+
 //-----------------------------------------------------------------
 void AlarmWidget::setTime(const Alarm::AlarmTime& time)
 {
@@ -260,6 +350,12 @@ void AlarmWidget::onPausePressed()
   }
 
   m_alarm->pause(m_alarm->isRunning());
+
+  // a paused alarm isn't urgent, the deadline is set again on the first tic once resumed.
+  if(m_logiled && !m_alarm->isRunning())
+    m_logiled->setItemDeadline(name(), -1);
+
+  emit stateChanged();
 }
 
 //-----------------------------------------------------------------
@@ -290,9 +386,13 @@ void AlarmWidget::setAlarm(std::unique_ptr<Alarm> alarm)
 //-----------------------------------------------------------------
 void AlarmWidget::onAlarmTic()
 {
-  setTime(m_alarm->remainingTime());
-
-  m_frame->setProgress(m_alarm->precisionProgress()/100.);
+  // hidden widgets (collapsed groups) are refreshed when shown again.
+  if(isVisible())
+  {
+    setTime(m_alarm->remainingTime());
+    m_frame->setProgress(m_alarm->precisionProgress()/100.);
+    update();
+  }
 
   if(m_icon)
     m_icon->setToolTip(QString("%1\nRemaining time: %2\nCompleted: %3%").arg(m_configuration.name).arg(m_alarm->remainingTimeText()).arg(m_alarm->progress()));
@@ -301,9 +401,12 @@ void AlarmWidget::onAlarmTic()
     m_widget->setProgress(m_alarm->precisionProgress());
 
   if(m_logiled)
+  {
     m_logiled->updateItem(name(), m_alarm->progress());
+    m_logiled->setItemDeadline(name(), m_alarm->remainingSeconds());
+  }
 
-  repaint();
+  emit progressChanged(m_alarm->precisionProgress());
 }
 
 //-----------------------------------------------------------------
@@ -318,6 +421,11 @@ void AlarmWidget::onAlarmTimeout()
 {
   if(m_configuration.isTimer && !m_configuration.timerLoops)
     stop();
+  else
+    emit stateChanged();
+
+  if(m_logiled)
+    m_logiled->flash(QColor{color()});
 
   auto dialog = new QMessageBox(QMessageBox::Information,
                                 m_configuration.name,
@@ -330,22 +438,18 @@ void AlarmWidget::onAlarmTimeout()
   connect(dialog, SIGNAL(finished(int)),
           this,   SLOT(onDialogFinished()));
 
-  m_sound = std::make_unique<QSoundEffect>(this);
-  m_soundFile = std::unique_ptr<QTemporaryFile>(QTemporaryFile::createNativeFile(soundFiles[m_configuration.sound]));
-  m_sound->setSource(QUrl::fromLocalFile(m_soundFile->fileName()));
-  m_sound->setLoopCount(QSoundEffect::Infinite);
-  m_sound->setVolume(m_configuration.soundVolume/100.0);
+  // a looping timer can time out again before the previous dialog is closed.
+  SoundMixer::getInstance().stop(m_sound);
+  m_sound = SoundMixer::getInstance().play(SoundBank::source(m_configuration), m_configuration.soundVolume, true);
 
-  m_sound->play();
   dialog->open();
 }
 
 //-----------------------------------------------------------------
 void AlarmWidget::onDialogFinished()
 {
-  m_sound->stop();
-  m_sound = nullptr;
-  m_soundFile = nullptr;
+  SoundMixer::getInstance().stop(m_sound);
+  m_sound = -1;
 
   auto dialog = qobject_cast<QMessageBox *>(sender());
   dialog->deleteLater();
@@ -362,53 +466,28 @@ void AlarmWidget::onSettingsPressed()
   auto colors = m_parent->usedColors();
   colors.removeOne(m_configuration.color);
 
-  NewAlarmDialog dialog(names, colors, this);
-  dialog.setWindowTitle(tr("Modify Alarm"));
-  dialog.setName(m_configuration.name);
-  dialog.setMessage(m_configuration.message);
-  dialog.setColor(m_configuration.color);
-  dialog.setIsTimer(m_configuration.isTimer);
-  dialog.setTimerTime(m_configuration.timerTime);
-  dialog.setClockDateTime(m_configuration.clockDateTime);
-  dialog.setTimerLoop(m_configuration.timerLoops);
-  dialog.setSound(m_configuration.sound);
-  dialog.setSoundVolume(m_configuration.soundVolume);
-  dialog.setShowInTray(m_configuration.useTray);
-  dialog.setShowInDesktop(m_configuration.useDesktopWidget);
-  dialog.setShowInKeyboard(m_configuration.useLogiled);
-  dialog.setDesktopWidgetPosition(m_configuration.widgetPosition);
-  dialog.setWidgetOpacity(m_configuration.widgetOpacity);
-
-  dialog.exec();
-
-  if(dialog.result() == QDialog::Accepted)
+  auto dialog = m_parent->alarmDialog();
+  dialog->setWindowTitle(tr("Modify Alarm"));
+  dialog->setConfiguration(m_configuration, names, colors, m_parent->groupNames());
+
+  if(dialog->exec() == QDialog::Accepted)
   {
-    AlarmConfiguration conf;
-    conf.name    = dialog.name();
-    conf.message = dialog.message();
-    conf.color   = dialog.color().toLower();
-    conf.isTimer = dialog.isTimer();
+    reconfigure(dialog->configuration());
+  }
+}
 
-    if(conf.isTimer)
-    {
-      conf.timerTime  = dialog.timerTime();
-      conf.timerLoops = dialog.timerLoop();
-    }
-    else
-    {
-      conf.clockDateTime = dialog.clockDateTime();
-    }
+//-----------------------------------------------------------------
+void AlarmWidget::reconfigure(const AlarmConfiguration &conf)
+{
+  // clock alarms are stopped too, they are started again by setConfiguration().
+  if(m_started) stop();
 
-    conf.sound            = dialog.sound();
-    conf.soundVolume      = dialog.soundVolume();
-    conf.useTray          = dialog.showInTray();
-    conf.useDesktopWidget = dialog.showInDesktop();
-    conf.useLogiled       = dialog.showInKeyboard();
-    conf.widgetPosition   = dialog.desktopWidgetPosition();
-    conf.widgetOpacity    = dialog.widgetOpacity();
+  const auto previousName = m_configuration.name;
+  setConfiguration(conf);
 
-    setConfiguration(conf);
-  }
+  emit progressChanged(0);
+  emit stateChanged();
+  emit configurationChanged(previousName);
 }
 
 //-----------------------------------------------------------------
@@ -439,6 +518,10 @@ void AlarmWidget::setConfiguration(const AlarmConfiguration &conf)
     m_alarm = nullptr;
 
   m_configuration = conf;
+  m_trayIcons.clear();
+
+  // the sound is ready before the alarm times out.
+  SoundBank::getInstance().prepare(SoundBank::source(conf));
 
   setColor(m_configuration.color);
   m_name->setText(COLOR_QSTRING.arg(m_contrastColor).arg(conf.name));
@@ -523,12 +606,84 @@ void AlarmWidget::setConfiguration(const AlarmConfiguration &conf)
 //-----------------------------------------------------------------
 const struct AlarmConfiguration AlarmWidget::alarmConfiguration() const
 {
-  return m_configuration;
+  auto conf = m_configuration;
+  conf.state = alarmState();
+
+  return conf;
+}
+
+//-----------------------------------------------------------------
+AlarmState AlarmWidget::alarmState() const
+{
+  AlarmState state;
+
+  if(m_configuration.isTimer && m_started && m_alarm)
+  {
+    if(m_alarm->isRunning())
+    {
+      state.status   = AlarmState::Status::RUNNING;
+      state.deadline = QDateTime::currentMSecsSinceEpoch() + m_alarm->remainingSeconds() * 1000;
+    }
+    else
+    {
+      state.status    = AlarmState::Status::PAUSED;
+      state.remaining = m_alarm->remainingSeconds();
+    }
+  }
+
+  return state;
+}
+
+//-----------------------------------------------------------------
+void AlarmWidget::restoreState(const AlarmState &state)
+{
+  if(!m_configuration.isTimer || state.status == AlarmState::Status::STOPPED || m_started) return;
+
+  long long remaining = state.remaining;
+
+  if(state.status == AlarmState::Status::RUNNING)
+  {
+    remaining = (state.deadline - QDateTime::currentMSecsSinceEpoch() + 999) / 1000;
+
+    if(remaining <= 0 && m_configuration.timerLoops)
+    {
+      const long long duration = QTime{0,0,0}.secsTo(m_configuration.timerTime);
+      if(duration > 0)
+        remaining = duration - ((-remaining) % duration);
+    }
+  }
+
+  start();
+  m_alarm->setRemainingSeconds(remaining);
+
+  setTime(m_alarm->remainingTime());
+  m_frame->setProgress(m_alarm->precisionProgress()/100.);
+
+  if(m_icon)
+    setTrayIcon(QString(":/MultiAlarm/%1.ico").arg(m_alarm->completedIntervals()));
+
+  if(m_widget)
+    m_widget->setProgress(m_alarm->precisionProgress());
+
+  if(m_logiled)
+    m_logiled->updateItem(name(), m_alarm->progress());
+
+  if(state.status == AlarmState::Status::PAUSED)
+    onPausePressed();
+
+  emit progressChanged(m_alarm->precisionProgress());
+  emit stateChanged();
 }
 
 //-----------------------------------------------------------------
 void AlarmWidget::setTrayIcon(const QString &icon)
 {
+  if(m_trayIcons.contains(icon))
+  {
+    m_icon->setIcon(m_trayIcons.value(icon));
+    return;
+  }
+
   auto qIcon = QIcon(icon);
 
   auto qPixmap = qIcon.pixmap(128,128);
@@ -555,5 +710,8 @@ void AlarmWidget::setTrayIcon(const QString &icon)
     }
   }
 
-  m_icon->setIcon(QIcon(QPixmap::fromImage(qimage)));
+  const auto tinted = QIcon(QPixmap::fromImage(qimage));
+  m_trayIcons.insert(icon, tinted);
+
+  m_icon->setIcon(tinted);
 }
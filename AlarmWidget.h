@@ -22,41 +22,23 @@
 
 // Project
 #include <Alarm.h>
+#include <AlarmConfiguration.h>
 #include "ui_AlarmWidget.h"
 
 // Qt
 #include <QWidget>
 #include <QSystemTrayIcon>
+#include <QHash>
+#include <QIcon>
 
 class QTime;
-class QSoundEffect;
-class QTemporaryFile;
+class QMouseEvent;
+class QShowEvent;
 
 class DesktopWidget;
 class MultiAlarm;
 class LogiLED;
 
-/** \struct AlarmConfiguration
- * \brief Holds all the relevant information about an alarm and it's notifications.
- */
-struct AlarmConfiguration
-{
-    QString   name;             /** name of the alarm.                                            */
-    QString   message;          /** message of the alarm to show on completion.                   */
-    QString   color;            /** name of the color of the alarm.                               */
-    bool      isTimer;          /** true if the alarm is a timer.                                 */
-    QTime     timerTime;        /** duration of the timer alarm.                                  */
-    bool      timerLoops;       /** true if the timer loops.                                      */
-    QDateTime clockDateTime;    /** date and timer of the clock alarm.                            */
-    int       sound;            /** sound used for the finished alarm notification.               */
-    int       soundVolume;      /** volume for the sound in [0 (silence) - 100 (loudest) ]        */
-    bool      useTray;          /** true if the alarm uses the tray for notifications.            */
-    bool      useDesktopWidget; /** true if the alarm uses a desktop widget for notifications.    */
-    bool      useLogiled;       /** true if the alarm uses the keyboard lights for notifications. */
-    QPoint    widgetPosition;   /** position of the desktop widget.                               */
-    int       widgetOpacity;    /** opacity of the desktop widget in [0-100]                      */
-};
-
 /** \class AlarmWidget
  * \brief Widget with alarm information and controls to
  *        start, pause, stop and delete an alarm.
@@ -85,11 +67,29 @@ class AlarmWidget
      */
     void setConfiguration(const AlarmConfiguration &conf);
 
+    /** \brief Stops the alarm and changes its configuration, notifying the change.
+     * \param[in] configuration AlarmConfiguration containing the new details of the alarm.
+     *
+     */
+    void reconfigure(const AlarmConfiguration &conf);
+
     /** \brief Returns the configuration of the alarm.
      *
      */
     const struct AlarmConfiguration alarmConfiguration() const;
 
+    /** \brief Returns the run state of the alarm.
+     *
+     */
+    AlarmState alarmState() const;
+
+    /** \brief Resumes the countdown from a stored run state. A running timer whose deadline passed while
+     *         the application wasn't running times out on the next tic if it doesn't loop.
+     * \param[in] state alarm run state.
+     *
+     */
+    void restoreState(const AlarmState &state);
+
     /** \brief Returns the name of the alarm, needed to avoid duplicated names.
      *
      */
@@ -100,9 +100,83 @@ class AlarmWidget
      */
     const QString color() const;
 
+    /** \brief Starts the alarm if it's stopped or resumes it if it's paused.
+     *
+     */
+    void startAlarm();
+
+    /** \brief Pauses the alarm if it's a running timer.
+     *
+     */
+    void pauseAlarm();
+
+    /** \brief Stops the alarm if it's a started timer.
+     *
+     */
+    void stopAlarm();
+
+    /** \brief Returns true if the alarm has been started (running or paused) and false otherwise.
+     *
+     */
+    bool isStarted() const;
+
+    /** \brief Returns true if the alarm is running and false if it's stopped or paused.
+     *
+     */
+    bool isRunning() const;
+
+    /** \brief Returns the progress of the alarm in [0.0-100.0].
+     *
+     */
+    double progress() const;
+
+    /** \brief Returns the date and time the alarm will time out if it's running, or an invalid
+     *         QDateTime if it's stopped or paused.
+     *
+     */
+    QDateTime deadline() const;
+
+    /** \brief Sets the selection state of the widget.
+     * \param[in] value true to select and false otherwise.
+     *
+     */
+    void setSelected(bool value);
+
+    /** \brief Returns true if the widget is selected and false otherwise.
+     *
+     */
+    bool isSelected() const;
+
   signals:
     void deleteAlarm();
 
+    /** \brief Signals a selection click on the widget.
+     * \param[out] extend true to add to the current selection and false to replace it.
+     *
+     */
+    void selectionRequested(bool extend);
+
+    /** \brief Signals a change in the progress of the alarm.
+     * \param[out] value progress value in [0.0-100.0].
+     *
+     */
+    void progressChanged(double value);
+
+    /** \brief Signals that the alarm has been started, paused, resumed, stopped or restarted.
+     *
+     */
+    void stateChanged();
+
+    /** \brief Signals that the alarm has been reconfigured by the user.
+     * \param[out] previousName name of the alarm before the change.
+     *
+     */
+    void configurationChanged(const QString &previousName);
+
+  protected:
+    virtual void mousePressEvent(QMouseEvent *e) override;
+    virtual void showEvent(QShowEvent *e) override;
+
   private slots:
     /** \brief Modifies the UI and desktop widget time.
      *
@@ -184,14 +258,15 @@ class AlarmWidget
     void setTrayIcon(const QString &icon);
 
     bool                             m_started;       /** true if the alarm has been started and false otherwise.  */
+    bool                             m_selected;      /** true if the widget is selected and false otherwise.      */
     QString                          m_contrastColor; /** color of the text of the widget (always black or white). */
     std::unique_ptr<Alarm>           m_alarm;         /** alarm class object.                                      */
     AlarmConfiguration               m_configuration; /** alarm configuration.                                     */
     std::unique_ptr<QSystemTrayIcon> m_icon;          /** system tray icon.                                        */
     std::unique_ptr<DesktopWidget>   m_widget;        /** desktop widget.                                          */
     LogiLED                         *m_logiled;       /** LogiLED instance.                                        */
-    std::unique_ptr<QSoundEffect>    m_sound;         /** alarm sound.                                             */
-    std::unique_ptr<QTemporaryFile>  m_soundFile;     /** local sound file in termporary directory.                */
+    int                              m_sound;         /** alarm sound playback identifier, -1 if not playing.      */
+    QHash<QString, QIcon>            m_trayIcons;     /** tinted tray icons cache, key is the base icon name.      */
 
     MultiAlarm *m_parent;                             /** main application dialog pointer, used to get the used    *
                                                         * names and colors when reconfiguring.                     */
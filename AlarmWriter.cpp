@@ -0,0 +1,431 @@
+/*
+ File: AlarmWriter.cpp
+ Created on: 19/10/2026
+ Author: Felix de las Pozas Alvarez
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Project
+#include <AlarmWriter.h>
+#include <AlarmStore.h>
+
+// Qt
+#include <QSettings>
+#include <QThread>
+#include <QDir>
+#include <QFileInfo>
+#include <QDebug>
+
+const int WRITE_DELAY     = 2000;      // milliseconds without changes before writing.
+const int MAX_WRITE_DELAY = 10000;     // milliseconds, limit for a continuous burst of changes.
+const int COMPACT_ENTRIES = 1000;      // journal entries that trigger a compaction into the store.
+const qint64 COMPACT_SIZE = 1024*1024; // journal bytes that trigger a compaction into the store.
+
+//-----------------------------------------------------------------
+AlarmWriter::AlarmWriter(const QString &journalPath, const QString &binaryPath, bool binary,
+                         const QString &settingsPath, const QSettings::Format settingsFormat,
+                         const QList<AlarmConfiguration> &stored, const QList<AlarmJournal::Entry> &journaled)
+: QObject          {nullptr}
+, m_journal        {std::make_unique<AlarmJournal>(journalPath)}
+, m_binaryPath     {binaryPath}
+, m_binary         {binary}
+, m_settingsPath   {settingsPath}
+, m_settingsFormat {settingsFormat}
+, m_entries        {0}
+, m_compact        {false}
+, m_timer          {this}
+, m_storeSize      {-1}
+{
+  m_timer.setSingleShot(true);
+
+  setStored(stored);
+  stampStore();
+
+  m_alarms = m_stored;
+  apply(journaled, true);
+
+  connect(&m_timer, SIGNAL(timeout()),
+          this,     SLOT(write()));
+}
+
+//-----------------------------------------------------------------
+void AlarmWriter::append(const AlarmJournal::Entry &entry)
+{
+  QMetaObject::invokeMethod(this, [this, entry]()
+  {
+    apply(QList<AlarmJournal::Entry>{entry}, m_journal->append(entry));
+  }, Qt::QueuedConnection);
+}
+
+//-----------------------------------------------------------------
+void AlarmWriter::append(const QList<AlarmJournal::Entry> &entries)
+{
+  QMetaObject::invokeMethod(this, [this, entries]()
+  {
+    apply(entries, m_journal->append(entries));
+  }, Qt::QueuedConnection);
+}
+
+//-----------------------------------------------------------------
+void AlarmWriter::apply(const QList<AlarmJournal::Entry> &entries, bool journaled)
+{
+  AlarmJournal::apply(entries, m_alarms);
+
+  for(const auto &entry: entries)
+  {
+    m_changed.insert(entry.name);
+
+    if(entry.operation == AlarmJournal::Operation::CREATE || entry.operation == AlarmJournal::Operation::MODIFY)
+      m_changed.insert(entry.configuration.name);
+  }
+
+  m_entries += entries.size();
+
+  // the store is only written when the journal has grown enough, replaying a long journal on startup
+  // would be slower than reading the store. Changes that couldn't be journaled are written at once.
+  if(!m_compact && (!journaled || isCompactionDue()))
+  {
+    m_compact = true;
+
+    // queued, the constructor runs in the thread creating the writer.
+    QMetaObject::invokeMethod(this, "write", Qt::QueuedConnection);
+  }
+}
+
+//-----------------------------------------------------------------
+bool AlarmWriter::isCompactionDue() const
+{
+  return m_entries >= COMPACT_ENTRIES || m_journal->size() >= COMPACT_SIZE;
+}
+
+//-----------------------------------------------------------------
+void AlarmWriter::setValues(const QVariantMap &values)
+{
+  QMetaObject::invokeMethod(this, [this, values]()
+  {
+    for(auto it = values.constBegin(); it != values.constEnd(); ++it)
+    {
+      // removing a key discards the pending values of its subkeys. Keys are sorted so the
+      // removal is written before any new subkey value.
+      if(!it.value().isValid())
+      {
+        const auto prefix = it.key() + "/";
+        for(auto pending = m_values.begin(); pending != m_values.end();)
+        {
+          if(pending.key().startsWith(prefix)) pending = m_values.erase(pending);
+          else ++pending;
+        }
+      }
+
+      m_values.insert(it.key(), it.value());
+    }
+
+    schedule();
+  }, Qt::QueuedConnection);
+}
+
+//-----------------------------------------------------------------
+void AlarmWriter::setStore(bool binary)
+{
+  QMetaObject::invokeMethod(this, [this, binary]()
+  {
+    if(binary != m_binary)
+    {
+      // the alarms are written to the new store before selecting it, and the old store is
+      // cleared last so a failure at any point leaves the alarms in the selected store.
+      if(!writeAlarms(binary))
+      {
+        const auto store = binary ? QDir::toNativeSeparators(m_binaryPath) : tr("settings");
+        emit error(tr("Unable to write the alarms to the %1 store.").arg(store));
+      }
+      else
+      {
+        AlarmStore::setUsesBinaryStore(settings(), binary);
+        settings().sync();
+
+        if(binary)
+        {
+          AlarmStore::clearAlarms(settings());
+          settings().sync();
+        }
+        else
+        {
+          QFile::remove(m_binaryPath);
+        }
+
+        m_binary = binary;
+        onAlarmsWritten();
+      }
+    }
+
+    emit storeChanged(m_binary);
+  }, Qt::QueuedConnection);
+}
+
+//-----------------------------------------------------------------
+void AlarmWriter::finish()
+{
+  QMetaObject::invokeMethod(this, [this]()
+  {
+    // the next start doesn't need to replay the journal.
+    if(m_entries > 0 || !m_changed.isEmpty())
+      m_compact = true;
+
+    write();
+    thread()->quit();
+  }, Qt::QueuedConnection);
+}
+
+//-----------------------------------------------------------------
+void AlarmWriter::schedule()
+{
+  if(!m_timer.isActive())
+    m_delay.start();
+
+  // a continuous burst of changes is written every MAX_WRITE_DELAY milliseconds.
+  if(m_delay.elapsed() < MAX_WRITE_DELAY)
+    m_timer.start(WRITE_DELAY);
+}
+
+//-----------------------------------------------------------------
+void AlarmWriter::write()
+{
+  m_timer.stop();
+
+  if(!m_values.isEmpty())
+  {
+    for(auto it = m_values.constBegin(); it != m_values.constEnd(); ++it)
+    {
+      if(it.value().isValid()) settings().setValue(it.key(), it.value());
+      else                     settings().remove(it.key());
+    }
+
+    settings().sync();
+
+    if(settings().status() == QSettings::NoError)
+      m_values.clear();
+    else
+      qWarning() << "Unable to write settings" << settings().fileName();
+  }
+
+  if(!m_compact) return;
+
+  if(!compact())
+  {
+    qWarning() << "Unable to write alarms to the" << (m_binary ? m_binaryPath : QString("settings")) << "store.";
+
+    // the changes are still in the journal, the compaction is retried.
+    schedule();
+    return;
+  }
+
+  m_compact = false;
+}
+
+//-----------------------------------------------------------------
+bool AlarmWriter::compact()
+{
+  // external modifications not yet detected would be overwritten. They are sent to the GUI and applied
+  // to the alarms too. The store is only read again if its file has changed since the writer last read
+  // or wrote it.
+  QList<AlarmConfiguration> changed;
+  QStringList removed;
+  if(isStoreModified() && detectEdits(changed, removed))
+    applyEdits(changed, removed);
+
+  if(!writeAlarms(m_binary)) return false;
+
+  onAlarmsWritten();
+
+  return true;
+}
+
+//-----------------------------------------------------------------
+void AlarmWriter::onAlarmsWritten()
+{
+  m_stored = m_alarms;
+  m_changed.clear();
+  stampStore();
+
+  // every change of the journal is in the store.
+  m_journal->clear();
+  m_entries = 0;
+}
+
+//-----------------------------------------------------------------
+bool AlarmWriter::writeAlarms(bool binary)
+{
+  // the binary store is a single file of fixed size records replaced atomically, it's always written whole.
+  if(binary)
+    return AlarmStore::saveBinary(m_binaryPath, m_alarms.values());
+
+  if(binary != m_binary)
+  {
+    // alarms moved from the binary store, the settings don't have any of them.
+    AlarmStore::clearAlarms(settings());
+    AlarmStore::writeAlarms(settings(), m_alarms.values());
+  }
+  else
+  {
+    // only the changed alarms that differ from the store are written, every key is a registry write on Windows.
+    for(const auto &name: m_changed)
+    {
+      const auto alarm  = m_alarms.constFind(name);
+      const auto stored = m_stored.constFind(name);
+
+      if(alarm == m_alarms.constEnd())
+      {
+        if(stored != m_stored.constEnd()) AlarmStore::removeAlarm(settings(), name);
+        continue;
+      }
+
+      const auto &conf = alarm.value();
+      if(stored == m_stored.constEnd() || !stored.value().sameDefinition(conf))
+      {
+        AlarmStore::writeAlarm(settings(), conf);
+      }
+      else
+      {
+        const auto &state = stored.value().state;
+        if(state.status != conf.state.status || state.deadline != conf.state.deadline || state.remaining != conf.state.remaining)
+          AlarmStore::writeState(settings(), conf.name, conf.state);
+      }
+    }
+  }
+
+  // QSettings writes INI files with a temporary file, replacing them atomically too.
+  settings().sync();
+
+  return settings().status() == QSettings::NoError;
+}
+
+//-----------------------------------------------------------------
+void AlarmWriter::checkStore()
+{
+  QMetaObject::invokeMethod(this, [this]()
+  {
+    // the notifications of the writer's own writes don't read the store again.
+    if(!isStoreModified()) return;
+
+    QList<AlarmConfiguration> changed;
+    QStringList removed;
+    detectEdits(changed, removed);
+  }, Qt::QueuedConnection);
+}
+
+//-----------------------------------------------------------------
+bool AlarmWriter::detectEdits(QList<AlarmConfiguration> &changed, QStringList &removed)
+{
+  QList<AlarmConfiguration> alarms;
+
+  if(m_binary)
+  {
+    // a store being replaced is checked again on the next change.
+    bool ok;
+    alarms = AlarmStore::loadBinary(m_binaryPath, &ok);
+    if(!ok) return false;
+  }
+  else
+  {
+    settings().sync();
+    alarms = AlarmStore::readAlarms(settings());
+  }
+
+  QSet<QString> names;
+
+  // run states change all the time, only definitions are compared.
+  for(const auto &conf: alarms)
+  {
+    names.insert(conf.name);
+
+    const auto it = m_stored.constFind(conf.name);
+    if(it == m_stored.constEnd() || !it.value().sameDefinition(conf))
+      changed << conf;
+  }
+
+  for(auto it = m_stored.constBegin(); it != m_stored.constEnd(); ++it)
+    if(!names.contains(it.key())) removed << it.key();
+
+  setStored(alarms);
+  stampStore();
+
+  if(changed.isEmpty() && removed.isEmpty()) return false;
+
+  emit storeEdited(changed, removed);
+
+  return true;
+}
+
+//-----------------------------------------------------------------
+void AlarmWriter::applyEdits(const QList<AlarmConfiguration> &changed, const QStringList &removed)
+{
+  for(const auto &name: removed)
+    m_alarms.remove(name);
+
+  for(const auto &conf: changed)
+    m_alarms.insert(conf.name, conf);
+}
+
+//-----------------------------------------------------------------
+void AlarmWriter::setStored(const QList<AlarmConfiguration> &alarms)
+{
+  m_stored.clear();
+
+  for(const auto &conf: alarms)
+    m_stored.insert(conf.name, conf);
+}
+
+//-----------------------------------------------------------------
+QSettings &AlarmWriter::settings()
+{
+  // QSettings is reentrant, not thread-safe. This one is only used by the writer thread and shares
+  // the parsed file with the other instances in the process.
+  if(!m_settings)
+    m_settings = std::make_unique<QSettings>(m_settingsPath, m_settingsFormat);
+
+  return *m_settings;
+}
+
+//-----------------------------------------------------------------
+QString AlarmWriter::storePath() const
+{
+  if(m_binary) return m_binaryPath;
+
+  // the registry path of the native format on Windows isn't a file.
+  return QFileInfo(m_settingsPath).isFile() ? m_settingsPath : QString();
+}
+
+//-----------------------------------------------------------------
+bool AlarmWriter::isStoreModified() const
+{
+  const auto path = storePath();
+  if(path.isEmpty()) return false;
+
+  const QFileInfo info(path);
+  if(!info.exists()) return m_storeSize != -1;
+
+  return info.lastModified() != m_storeModified || info.size() != m_storeSize;
+}
+
+//-----------------------------------------------------------------
+void AlarmWriter::stampStore()
+{
+  const auto path = storePath();
+  const QFileInfo info(path);
+  const auto exists = !path.isEmpty() && info.exists();
+
+  m_storeModified = exists ? info.lastModified() : QDateTime();
+  m_storeSize     = exists ? info.size() : -1;
+}
@@ -0,0 +1,217 @@
+/*
+ File: AlarmWriter.h
+ Created on: 19/10/2026
+ Author: Felix de las Pozas Alvarez
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ALARMWRITER_H_
+#define ALARMWRITER_H_
+
+// Project
+#include <AlarmJournal.h>
+
+// Qt
+#include <QObject>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <QVariantMap>
+#include <QSettings>
+#include <QDateTime>
+#include <QSet>
+
+// C++
+#include <memory>
+
+/** \class AlarmWriter
+ * \brief Persistence worker living in its own thread. Journal entries are appended as they arrive and
+ *        applied to the writer's copy of the alarms, which is compacted into the store when the journal
+ *        grows past a limit and on exit. Settings values are written after a burst of changes has settled.
+ *        The GUI thread never waits for the disk.
+ *
+ *        The public methods can be called from any thread, the work is queued to the writer thread.
+ *
+ */
+class AlarmWriter
+: public QObject
+{
+    Q_OBJECT
+  public:
+    /** \brief AlarmWriter class constructor.
+     * \param[in] journalPath alarms journal file path.
+     * \param[in] binaryPath binary alarm store file path.
+     * \param[in] binary true if the alarms are in the binary store and false if they are in the settings.
+     * \param[in] settingsPath settings file path or registry path.
+     * \param[in] settingsFormat settings format.
+     * \param[in] stored alarms in the store.
+     * \param[in] journaled entries of the journal not yet in the store.
+     *
+     */
+    explicit AlarmWriter(const QString &journalPath, const QString &binaryPath, bool binary,
+                         const QString &settingsPath, const QSettings::Format settingsFormat,
+                         const QList<AlarmConfiguration> &stored, const QList<AlarmJournal::Entry> &journaled);
+
+    /** \brief AlarmWriter class virtual destructor.
+     *
+     */
+    virtual ~AlarmWriter()
+    {};
+
+    /** \brief Appends the entry to the journal.
+     * \param[in] entry journal entry.
+     *
+     */
+    void append(const AlarmJournal::Entry &entry);
+
+    /** \brief Appends the entries to the journal in a single write.
+     * \param[in] entries journal entries.
+     *
+     */
+    void append(const QList<AlarmJournal::Entry> &entries);
+
+    /** \brief Sets settings values to write. An invalid value removes the key and all its subkeys.
+     * \param[in] values settings values.
+     *
+     */
+    void setValues(const QVariantMap &values);
+
+    /** \brief Moves the alarms to the given store. Emits storeChanged() when finished.
+     * \param[in] binary true to use the binary store and false to use the settings.
+     *
+     */
+    void setStore(bool binary);
+
+    /** \brief Writes the pending settings values, compacts the journal into the store and stops the writer thread.
+     *
+     */
+    void finish();
+
+  public slots:
+    /** \brief Reads the store if its file has changed and emits storeEdited() if the alarms are not the ones
+     *         last written, because the store has been modified externally.
+     *
+     */
+    void checkStore();
+
+  signals:
+    void storeChanged(bool binary);
+    void error(const QString &message);
+    void storeEdited(const QList<AlarmConfiguration> &changed, const QStringList &removed);
+
+  private slots:
+    /** \brief Writes the pending settings values and compacts the journal if requested.
+     *
+     */
+    void write();
+
+  private:
+    /** \brief Starts or extends the delay before the next write.
+     *
+     */
+    void schedule();
+
+    /** \brief Applies the entries to the alarms and compacts the journal if it has grown past the limits.
+     * \param[in] entries journal entries.
+     * \param[in] journaled true if the entries are in the journal and false if appending them failed.
+     *
+     */
+    void apply(const QList<AlarmJournal::Entry> &entries, bool journaled);
+
+    /** \brief Returns true if the journal has grown past the limits and must be compacted.
+     *
+     */
+    bool isCompactionDue() const;
+
+    /** \brief Writes the changed alarms to the store and clears the journal. Returns true on success and
+     *         false otherwise.
+     *
+     */
+    bool compact();
+
+    /** \brief Marks the alarms as written to the store and clears the journal.
+     *
+     */
+    void onAlarmsWritten();
+
+    /** \brief Writes the alarms to the given store. Returns true on success and false otherwise.
+     *         The settings store only gets the changed alarms that differ from the ones in it, the binary
+     *         store file is replaced.
+     * \param[in] binary true to write to the binary store and false to write to the settings.
+     *
+     */
+    bool writeAlarms(bool binary);
+
+    /** \brief Reads the store and emits storeEdited() with the differences with the alarms known to be
+     *         in the store. Returns true if the store has been modified externally and false otherwise.
+     * \param[out] changed added or modified alarms.
+     * \param[out] removed names of the removed alarms.
+     *
+     */
+    bool detectEdits(QList<AlarmConfiguration> &changed, QStringList &removed);
+
+    /** \brief Applies the external modifications of the store to the alarms, the way the GUI applies
+     *         them to its alarms.
+     * \param[in] changed added or modified alarms.
+     * \param[in] removed names of the removed alarms.
+     *
+     */
+    void applyEdits(const QList<AlarmConfiguration> &changed, const QStringList &removed);
+
+    /** \brief Sets the alarms known to be in the store.
+     * \param[in] alarms alarm configurations.
+     *
+     */
+    void setStored(const QList<AlarmConfiguration> &alarms);
+
+    /** \brief Returns the settings object of the writer thread, created on first use.
+     *
+     */
+    QSettings &settings();
+
+    /** \brief Returns the path of the file of the current store, empty if the settings aren't a file.
+     *
+     */
+    QString storePath() const;
+
+    /** \brief Returns true if the store file has changed since the last time it was read or written
+     *         by the writer, comparing its modification time and size. The registry isn't checked.
+     *
+     */
+    bool isStoreModified() const;
+
+    /** \brief Records the modification time and size of the store file after reading or writing it.
+     *
+     */
+    void stampStore();
+
+    std::unique_ptr<AlarmJournal> m_journal;        /** alarm changes journal.                                      */
+    const QString                 m_binaryPath;     /** binary alarm store file path.                               */
+    bool                          m_binary;         /** true if the alarms are in the binary store.                 */
+    const QString                 m_settingsPath;   /** settings file path or registry path.                        */
+    const QSettings::Format       m_settingsFormat; /** settings format.                                            */
+    std::unique_ptr<QSettings>    m_settings;       /** settings object of the writer thread.                       */
+    QMap<QString, AlarmConfiguration> m_alarms;     /** alarms, the store with the journal entries applied.         */
+    QMap<QString, AlarmConfiguration> m_stored;     /** alarms in the store, to detect external modifications.      */
+    QSet<QString>                 m_changed;        /** names of the alarms changed since the store was written.    */
+    qsizetype                     m_entries;        /** number of entries in the journal.                           */
+    bool                          m_compact;        /** true if the journal must be compacted into the store.       */
+    QVariantMap                   m_values;         /** settings values not yet written.                            */
+    QTimer                        m_timer;          /** write delay timer.                                          */
+    QElapsedTimer                 m_delay;          /** time since the first unwritten change.                      */
+    QDateTime                     m_storeModified;  /** modification time of the store file when last read/written. */
+    qint64                        m_storeSize;      /** size of the store file when last read/written.              */
+};
+
+#endif // ALARMWRITER_H_
@@ -19,13 +19,12 @@
 
 // project
 #include <DesktopWidget.h>
+#include <ScreenGeometry.h>
 
 // Qt
 #include <QPainter>
 #include <QPointF>
 #include <QMouseEvent>
-#include <QScreen>
-#include <QApplication>
 
 const int DesktopWidget::WIDGET_SIZE = 100;
 
@@ -46,9 +45,8 @@ DesktopWidget::DesktopWidget(bool dragEnable, QWidget *parent)
   if(dragEnable)
     setWindowFlags(windowFlags() & ~Qt::WindowTransparentForInput);
 
-  auto desktopRect = QApplication::screens().at(0)->availableVirtualGeometry();
-  m_limitX = desktopRect.width()-WIDGET_SIZE;
-  m_limitY = desktopRect.height()-WIDGET_SIZE;
+  connect(&ScreenGeometry::getInstance(), SIGNAL(changed()),
+          this,                           SLOT(onScreensChanged()));
 
   setGeometry(QRect(0,0, WIDGET_SIZE, WIDGET_SIZE));
   setWindowOpacity(0.60);
@@ -119,17 +117,18 @@ void DesktopWidget::setPosition(const QPoint& position)
 {
   if(position != pos())
   {
-    auto newPosition = position;
-    if(newPosition.x() < 0) newPosition.setX(0);
-    if(newPosition.y() < 0) newPosition.setY(0);
-
-    if(newPosition.x() > m_limitX) newPosition.setX(m_limitX);
-    if(newPosition.y() > m_limitY) newPosition.setY(m_limitY);
-
-    move(newPosition);
+    move(ScreenGeometry::getInstance().clamp(position));
   }
 }
 
+//-----------------------------------------------------------------
+void DesktopWidget::onScreensChanged()
+{
+  // a widget on a removed or resized screen is moved back inside the desktop.
+  const auto position = ScreenGeometry::getInstance().clamp(pos());
+  if(position != pos()) move(position);
+}
+
 //-----------------------------------------------------------------
 void DesktopWidget::setOpacity(const int opacity)
 {
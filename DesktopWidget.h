@@ -79,6 +79,12 @@ class DesktopWidget
   signals:
     void beingDragged();
 
+  private slots:
+    /** \brief Keeps the widget inside the desktop when the screens change.
+     *
+     */
+    void onScreensChanged();
+
   protected:
     virtual void mousePressEvent(QMouseEvent *e) override final;
     virtual void mouseReleaseEvent(QMouseEvent *e) override final;
@@ -94,9 +100,6 @@ class DesktopWidget
 
     bool   m_buttonDown;     /** true if the left mouse button is down and false otherwise. */
     QPoint m_point;          /** dragging point. */
-
-    int m_limitX;            /** X limit in global screen coordinates. */
-    int m_limitY;            /** Y limit in global screen coordinates. */
 };
 
 #endif // DESKTOPWIDGET_H_
@@ -0,0 +1,81 @@
+/*
+ File: LedDevice.cpp
+ Created on: 19/10/2026
+ Author: Felix de las Pozas Alvarez
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Project
+#include <LedDevice.h>
+#include <MockLedDevice.h>
+#ifdef USE_LOGITECH_SDK
+#include <LogitechLedDevice.h>
+#endif
+
+// Qt
+#include <QDebug>
+
+const char *BACKEND_VARIABLE = "MULTIALARM_LED_BACKEND";
+
+// column of each key in its keyboard bitmap row, the layout of the Logitech Gaming LED SDK.
+const std::array<quint8, LedDevice::KEY_COUNT> KEY_COLUMNS{ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15,
+                                                            0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20,
+                                                            0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20,
+                                                            0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 17, 18, 19,
+                                                            0, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 18, 19, 20,
+                                                            0, 1, 2, 5, 11, 12, 13, 14, 15, 16, 17, 18, 19 };
+
+// first key of each keyboard bitmap row.
+const std::array<LedDevice::Key, LedDevice::BITMAP_HEIGHT> ROW_FIRST_KEYS{ LedDevice::Key::ESC, LedDevice::Key::TILDE, LedDevice::Key::TAB,
+                                                                           LedDevice::Key::CAPS_LOCK, LedDevice::Key::LEFT_SHIFT, LedDevice::Key::LEFT_CONTROL };
+
+//-----------------------------------------------------------------
+int LedDevice::bitmapOffset(const Key key)
+{
+  const auto index = static_cast<int>(key);
+
+  int row = BITMAP_HEIGHT - 1;
+  while(index < static_cast<int>(ROW_FIRST_KEYS[row])) --row;
+
+  return (row * BITMAP_WIDTH + KEY_COLUMNS[index]) * 4;
+}
+
+//-----------------------------------------------------------------
+void LedDevice::restore()
+{
+  shutdown();
+  initialize();
+}
+
+//-----------------------------------------------------------------
+std::unique_ptr<LedDevice> LedDevice::create()
+{
+  auto backend = qEnvironmentVariable(BACKEND_VARIABLE).trimmed().toLower();
+
+#ifdef USE_LOGITECH_SDK
+  if(backend.isEmpty() || backend == "logitech")
+    return std::make_unique<LogitechLedDevice>();
+#else
+  if(backend.isEmpty()) backend = "none";
+#endif
+
+  if(backend == "mock")
+    return std::make_unique<MockLedDevice>();
+
+  if(backend != "none")
+    qWarning() << "Unknown or unavailable keyboard lights backend" << backend << "in" << BACKEND_VARIABLE;
+
+  return std::make_unique<NullLedDevice>();
+}
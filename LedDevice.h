@@ -0,0 +1,150 @@
+/*
+ File: LedDevice.h
+ Created on: 19/10/2026
+ Author: Felix de las Pozas Alvarez
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LEDDEVICE_H_
+#define LEDDEVICE_H_
+
+// Qt
+#include <QtGlobal>
+#include <QString>
+#include <QList>
+
+// C++
+#include <array>
+#include <memory>
+#include <string>
+
+/** \class LedDevice
+ * \brief Interface of the keyboard lights backends. The backend is chosen on startup with the
+ *        MULTIALARM_LED_BACKEND environment variable: "logitech" (default if built with the SDK),
+ *        "mock" or "none".
+ *
+ */
+class LedDevice
+{
+  public:
+    /** \brief Keys of the keyboard, independent of the backend, by rows.
+     *
+     */
+    enum class Key: quint8 { ESC = 0, F1, F2, F3, F4, F5, F6, F7, F8, F9, F10, F11, F12, PRINT_SCREEN, SCROLL_LOCK, PAUSE_BREAK,
+                             TILDE, ONE, TWO, THREE, FOUR, FIVE, SIX, SEVEN, EIGHT, NINE, ZERO, MINUS, EQUALS, BACKSPACE,
+                             INSERT, HOME, PAGE_UP, NUM_LOCK, NUM_SLASH, NUM_ASTERISK, NUM_MINUS,
+                             TAB, Q, W, E, R, T, Y, U, I, O, P, OPEN_BRACKET, CLOSE_BRACKET, BACKSLASH,
+                             KEYBOARD_DELETE, END, PAGE_DOWN, NUM_SEVEN, NUM_EIGHT, NUM_NINE, NUM_PLUS,
+                             CAPS_LOCK, A, S, D, F, G, H, J, K, L, SEMICOLON, APOSTROPHE, ENTER, NUM_FOUR, NUM_FIVE, NUM_SIX,
+                             LEFT_SHIFT, Z, X, C, V, B, N, M, COMMA, PERIOD, FORWARD_SLASH, RIGHT_SHIFT, ARROW_UP,
+                             NUM_ONE, NUM_TWO, NUM_THREE, NUM_ENTER,
+                             LEFT_CONTROL, LEFT_WINDOWS, LEFT_ALT, SPACE, RIGHT_ALT, RIGHT_WINDOWS, APPLICATION_SELECT,
+                             RIGHT_CONTROL, ARROW_LEFT, ARROW_DOWN, ARROW_RIGHT, NUM_ZERO, NUM_PERIOD };
+
+    static constexpr int KEY_COUNT      = 104;                                   /** number of keys.                       */
+    static constexpr int BITMAP_WIDTH   = 21;                                    /** keyboard bitmap columns.              */
+    static constexpr int BITMAP_HEIGHT  = 6;                                     /** keyboard bitmap rows.                 */
+    static constexpr int BITMAP_SIZE    = BITMAP_WIDTH * BITMAP_HEIGHT * 4;      /** keyboard bitmap size in bytes.        */
+
+    /** \brief Whole keyboard image, one BGRA pixel per key position in [0,255].
+     *
+     */
+    using Bitmap = std::array<quint8, BITMAP_SIZE>;
+
+    /** \brief Returns the offset of the key pixel in the keyboard bitmap.
+     * \param[in] key keyboard key.
+     *
+     */
+    static int bitmapOffset(const Key key);
+
+    /** \brief LedDevice class virtual destructor.
+     *
+     */
+    virtual ~LedDevice()
+    {};
+
+    /** \brief Starts the session with the device. Returns true if the device is available and false otherwise.
+     *
+     */
+    virtual bool initialize() = 0;
+
+    /** \brief Ends the session with the device.
+     *
+     */
+    virtual void shutdown() = 0;
+
+    /** \brief Restores the lighting of the user, by default restarting the session.
+     *
+     */
+    virtual void restore();
+
+    /** \brief Sets the color of all the keys not excluded at once. Returns true on success and false otherwise.
+     * \param[in] bitmap keyboard bitmap.
+     *
+     */
+    virtual bool setBitmap(const Bitmap &bitmap) = 0;
+
+    /** \brief Excludes the keys from the following bitmaps, they keep their lighting. The exclusions last
+     *         until the lighting of the user is restored. Returns true on success and false otherwise.
+     * \param[in] keys keyboard keys.
+     *
+     */
+    virtual bool excludeKeys(const QList<Key> &keys) = 0;
+
+    /** \brief Returns the version of the backend library.
+     *
+     */
+    virtual std::string version() const = 0;
+
+    /** \brief Returns the backend name.
+     *
+     */
+    virtual QString name() const = 0;
+
+    /** \brief Returns the backend selected by the MULTIALARM_LED_BACKEND environment variable. Never returns
+     *         nullptr, unknown or unavailable backends are replaced by an always unavailable one.
+     *
+     */
+    static std::unique_ptr<LedDevice> create();
+};
+
+/** \class NullLedDevice
+ * \brief Backend without device, never available.
+ *
+ */
+class NullLedDevice
+: public LedDevice
+{
+  public:
+    virtual bool initialize() override
+    { return false; }
+
+    virtual void shutdown() override
+    {};
+
+    virtual bool setBitmap(const Bitmap &) override
+    { return false; }
+
+    virtual bool excludeKeys(const QList<Key> &) override
+    { return false; }
+
+    virtual std::string version() const override
+    { return std::string(); }
+
+    virtual QString name() const override
+    { return "none"; }
+};
+
+#endif // LEDDEVICE_H_
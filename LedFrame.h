@@ -0,0 +1,115 @@
+/*
+ File: LedFrame.h
+ Created on: 19/10/2026
+ Author: Felix de las Pozas Alvarez
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LEDFRAME_H_
+#define LEDFRAME_H_
+
+// Project
+#include <LedDevice.h>
+
+// C++
+#include <array>
+#include <atomic>
+#include <type_traits>
+
+/** \struct LedFrame
+ * \brief Desired state of the keyboard lights, copied between threads so it must stay trivially copyable.
+ *
+ */
+struct LedFrame
+{
+    bool                                   restore; /** true to restore the lighting of the user, the rest is ignored. */
+    LedDevice::Bitmap                      bitmap;  /** colors of the keys.                                           */
+    std::array<bool, LedDevice::KEY_COUNT> used;    /** keys shown, the rest keep their lighting.                     */
+    quint16                                fade;    /** milliseconds to fade from the shown colors, 0 to show at once. */
+    bool                                   flash;   /** true to blink the keys until the next frame.                  */
+};
+
+static_assert(std::is_trivially_copyable<LedFrame>::value, "LedFrame is copied between threads without locks.");
+
+/** \brief Comparison operator for keyboard frames. Returns true if equal in all the keys and effect, the
+ *         fade duration isn't compared as it doesn't change the colors reached.
+ * \param[in] lhs keyboard frame.
+ * \param[in] rhs keyboard frame.
+ *
+ */
+inline bool operator==(const LedFrame &lhs, const LedFrame &rhs)
+{ return lhs.restore == rhs.restore && lhs.flash == rhs.flash && lhs.bitmap == rhs.bitmap && lhs.used == rhs.used; }
+
+/** \class LedMailbox
+ * \brief Single slot lock-free mailbox between one producer and one consumer thread. The producer
+ *        publishes frames that replace the unread one, the consumer takes only the latest frame.
+ *        Implemented as a triple buffer: each side owns a buffer and the third one is exchanged
+ *        atomically with a flag telling if it holds an unread frame.
+ *
+ */
+class LedMailbox
+{
+  public:
+    /** \brief LedMailbox class constructor.
+     *
+     */
+    LedMailbox()
+    : m_buffers{}
+    , m_middle {1}
+    , m_back   {0}
+    , m_front  {2}
+    {};
+
+    /** \brief Publishes the frame, dropping the previous one if unread. Returns true if the mailbox was
+     *         empty, the consumer must be woken up. Producer thread only.
+     * \param[in] frame keyboard frame.
+     *
+     */
+    bool publish(const LedFrame &frame)
+    {
+      m_buffers[m_back] = frame;
+
+      const auto previous = m_middle.exchange(m_back | FRESH, std::memory_order_acq_rel);
+      m_back = previous & INDEX;
+
+      return (previous & FRESH) == 0;
+    }
+
+    /** \brief Takes the latest frame. Returns false if there isn't an unread frame. Consumer thread only.
+     * \param[out] frame keyboard frame.
+     *
+     */
+    bool take(LedFrame &frame)
+    {
+      if((m_middle.load(std::memory_order_acquire) & FRESH) == 0) return false;
+
+      const auto previous = m_middle.exchange(m_front, std::memory_order_acq_rel);
+      m_front = previous & INDEX;
+      frame = m_buffers[m_front];
+
+      return true;
+    }
+
+  private:
+    static constexpr quint8 INDEX = 0x3; /** buffer index bits.         */
+    static constexpr quint8 FRESH = 0x4; /** unread frame flag bit.     */
+
+    std::array<LedFrame, 3> m_buffers; /** frame buffers.                                */
+    std::atomic<quint8>     m_middle;  /** exchanged buffer index and unread frame flag. */
+    quint8                  m_back;    /** buffer of the producer.                       */
+    quint8                  m_front;   /** buffer of the consumer.                       */
+};
+
+#endif // LEDFRAME_H_
@@ -0,0 +1,179 @@
+/*
+ File: LedWorker.cpp
+ Created on: 19/10/2026
+ Author: Felix de las Pozas Alvarez
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Project
+#include <LedWorker.h>
+
+// Qt
+#include <QtMath>
+
+// C++
+#include <algorithm>
+#include <cmath>
+
+const int DEFAULT_FRAME_RATE = 30;  // frames per second while animating.
+const int MAX_FRAME_RATE     = 60;  // frames per second, the keyboards don't refresh faster.
+const int FLASH_PERIOD       = 500; // milliseconds of a blink of the flash effect.
+
+//-----------------------------------------------------------------
+LedWorker::LedWorker(LedDevice *device, LedMailbox &mailbox)
+: QObject  {nullptr}
+, m_device {device}
+, m_mailbox{mailbox}
+, m_sent   {}
+, m_synced {false}
+, m_target {}
+, m_from   {}
+, m_timer  {this}
+{
+  m_timer.setTimerType(Qt::PreciseTimer);
+  m_timer.setInterval(1000 / DEFAULT_FRAME_RATE);
+
+  connect(&m_timer, SIGNAL(timeout()),
+          this,     SLOT(animate()));
+}
+
+//-----------------------------------------------------------------
+void LedWorker::wake()
+{
+  QMetaObject::invokeMethod(this, [this]() { write(); }, Qt::QueuedConnection);
+}
+
+//-----------------------------------------------------------------
+void LedWorker::setFrameRate(int fps)
+{
+  fps = std::clamp(fps, 0, MAX_FRAME_RATE);
+
+  QMetaObject::invokeMethod(this, [this, fps]()
+  {
+    m_timer.setInterval(fps > 0 ? 1000 / fps : 0);
+    animate();
+  }, Qt::QueuedConnection);
+}
+
+//-----------------------------------------------------------------
+void LedWorker::write()
+{
+  LedFrame frame;
+  bool taken = false;
+
+  // frames published while writing replace each other, only the last one is animated.
+  while(m_mailbox.take(frame))
+  {
+    if(frame.restore)
+    {
+      m_device->restore();
+      m_synced = false;
+      m_timer.stop();
+      m_clock.invalidate();
+      taken = false;
+      continue;
+    }
+
+    // the keys restored by a different set of keys have unknown colors, no fade from them.
+    const bool sameKeys = m_synced && frame.used == m_sent.used;
+
+    m_from = sameKeys ? m_sent.bitmap : frame.bitmap;
+    m_target = frame;
+    m_clock.start();
+    taken = true;
+  }
+
+  // while animating the frames are written at the timer pace.
+  if(taken && !m_timer.isActive())
+    animate();
+}
+
+//-----------------------------------------------------------------
+void LedWorker::animate()
+{
+  if(!m_clock.isValid()) return;
+
+  const bool enabled = m_timer.interval() > 0;
+  const auto elapsed = m_clock.elapsed();
+
+  auto frame = m_target;
+  bool animating = false;
+
+  if(enabled && elapsed < m_target.fade)
+  {
+    // smoothstep, so the fade doesn't start or end abruptly.
+    auto t = static_cast<double>(elapsed) / m_target.fade;
+    t = t * t * (3 - 2 * t);
+
+    for(int i = 0; i < LedDevice::BITMAP_SIZE; ++i)
+      frame.bitmap[i] = static_cast<quint8>(std::lround(m_from[i] + (m_target.bitmap[i] - m_from[i]) * t));
+
+    animating = true;
+  }
+
+  if(enabled && m_target.flash)
+  {
+    // the keys fade to black and back, starting lit.
+    const auto phase = static_cast<double>(elapsed % FLASH_PERIOD) / FLASH_PERIOD;
+    const auto level = 0.5 + 0.5 * std::cos(2 * M_PI * phase);
+
+    for(int i = 0; i < LedDevice::BITMAP_SIZE; i += 4)
+    {
+      for(int component: {0, 1, 2})
+        frame.bitmap[i + component] = static_cast<quint8>(std::lround(frame.bitmap[i + component] * level));
+    }
+
+    animating = true;
+  }
+
+  send(frame);
+
+  if(!animating)
+  {
+    m_timer.stop();
+    m_clock.invalidate();
+  }
+  else
+    if(!m_timer.isActive()) m_timer.start();
+}
+
+//-----------------------------------------------------------------
+void LedWorker::send(const LedFrame &frame)
+{
+  // the exclusions last until restored, a different set of keys needs a new session.
+  if(m_synced && frame.used != m_sent.used)
+  {
+    m_device->restore();
+    m_synced = false;
+  }
+
+  if(!m_synced)
+  {
+    QList<LedDevice::Key> excluded;
+    for(int i = 0; i < LedDevice::KEY_COUNT; ++i)
+    {
+      if(!frame.used[i]) excluded << static_cast<LedDevice::Key>(i);
+    }
+
+    m_device->excludeKeys(excluded);
+  }
+
+  // one call for all the keys, whatever the number of keys changed.
+  if(!m_synced || frame.bitmap != m_sent.bitmap)
+    m_device->setBitmap(frame.bitmap);
+
+  m_sent = frame;
+  m_synced = true;
+}
@@ -0,0 +1,99 @@
+/*
+ File: LedWorker.h
+ Created on: 19/10/2026
+ Author: Felix de las Pozas Alvarez
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LEDWORKER_H_
+#define LEDWORKER_H_
+
+// Project
+#include <LedFrame.h>
+
+// Qt
+#include <QObject>
+#include <QTimer>
+#include <QElapsedTimer>
+
+/** \class LedWorker
+ * \brief Writes the keyboard frames to the LED device from its own thread, so the latency of the
+ *        device never stalls the GUI. Only the latest published frame is written, with a single
+ *        bitmap call for the whole keyboard, and only if it changed since the previous one.
+ *
+ *        The fades and flashes of the frames are animated in the worker thread at a capped frame rate,
+ *        the animation timer is stopped when there is nothing to animate.
+ *
+ *        wake() and setFrameRate() can be called from any thread, the work is queued to the worker thread.
+ *
+ */
+class LedWorker
+: public QObject
+{
+    Q_OBJECT
+  public:
+    /** \brief LedWorker class constructor.
+     * \param[in] device keyboard lights backend, only used from the worker thread once started.
+     * \param[in] mailbox frames mailbox, the worker is the consumer.
+     *
+     */
+    explicit LedWorker(LedDevice *device, LedMailbox &mailbox);
+
+    /** \brief LedWorker class virtual destructor.
+     *
+     */
+    virtual ~LedWorker()
+    {};
+
+    /** \brief Queues the writing of the latest frame.
+     *
+     */
+    void wake();
+
+    /** \brief Sets the maximum number of frames written per second while animating.
+     * \param[in] fps frames per second, 0 to disable the animations.
+     *
+     */
+    void setFrameRate(int fps);
+
+  private slots:
+    /** \brief Writes the animation frame for the current time, and stops the animation timer if finished.
+     *
+     */
+    void animate();
+
+  private:
+    /** \brief Takes the latest frame and starts its animation.
+     *
+     */
+    void write();
+
+    /** \brief Writes the frame to the device, if different from the last one written.
+     * \param[in] frame keyboard frame.
+     *
+     */
+    void send(const LedFrame &frame);
+
+    LedDevice        *m_device;  /** keyboard lights backend.                                     */
+    LedMailbox       &m_mailbox; /** frames mailbox.                                              */
+    LedFrame          m_sent;    /** frame last written to the device.                            */
+    bool              m_synced;  /** false if the device state is unknown, the frame is written.  */
+    LedFrame          m_target;  /** latest frame taken, the animation ends in its colors.        */
+    LedDevice::Bitmap m_from;    /** colors shown when the latest frame was taken.                */
+    QElapsedTimer     m_clock;   /** time since the latest frame was taken.                       */
+    QTimer            m_timer;   /** animation timer, one timeout per frame.                      */
+};
+
+#endif // LEDWORKER_H_
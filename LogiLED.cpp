@@ -19,12 +19,7 @@
 
 // Project
 #include <LogiLED.h>
-
-// Logitech gaming SDK
-extern "C"
-{
-  #include <LogitechLEDLib.h>
-}
+#include <LedWorker.h>
 
 // Qt
 #include <QTimer>
@@ -33,28 +28,106 @@ extern "C"
 #include <QListIterator>
 
 // C++
+#include <algorithm>
 #include <chrono>
+#include <cmath>
+#include <limits>
 #include <thread>
 
-const QList<LogiLed::KeyName> KEYS { LogiLed::F1, LogiLed::F2, LogiLed::F3, LogiLed::F4, LogiLed::F5, LogiLed::F6, LogiLed::F7,
-                                     LogiLed::F8, LogiLed::F9, LogiLed::F10, LogiLed::F11, LogiLed::F12, LogiLed::PRINT_SCREEN,
-                                     LogiLed::SCROLL_LOCK, LogiLed::PAUSE_BREAK };
+using Key = LedDevice::Key;
+
+const int ROTATION_INTERVAL = 5000;  // milliseconds an item is shown before the next one.
+const double TAKEOVER_TIME  = 60;    // seconds to the deadline of an item to take the keyboard.
+const double MAX_REMAINING  = 86400; // seconds to the deadline of the items without one, the least shown.
+
+const int PROGRESS_FADE  = 1000; // milliseconds to fade the keys to a new progress.
+const int ALARM_FADE     = 500;  // milliseconds to cross-fade the keys from an alarm to another.
+const int FLASH_DURATION = 3000; // milliseconds the keys flash when an alarm times out.
+
+const QString NEW_ALARM = "NewAlarm"; // item of the preview of the new alarm dialog.
 
-using namespace LogiLed;
+// keys of each zone, in the order they fill with the progress.
+const std::array<QList<Key>, LogiLED::ZONE_COUNT> ZONE_KEYS{
+  QList<Key>{ Key::F1, Key::F2, Key::F3, Key::F4, Key::F5, Key::F6, Key::F7, Key::F8, Key::F9, Key::F10, Key::F11, Key::F12,
+              Key::PRINT_SCREEN, Key::SCROLL_LOCK, Key::PAUSE_BREAK },
+  QList<Key>{ Key::TILDE, Key::ONE, Key::TWO, Key::THREE, Key::FOUR, Key::FIVE, Key::SIX, Key::SEVEN, Key::EIGHT, Key::NINE,
+              Key::ZERO, Key::MINUS, Key::EQUALS, Key::BACKSPACE },
+  QList<Key>{ Key::Q, Key::W, Key::E, Key::R, Key::T, Key::Y, Key::U, Key::I, Key::O, Key::P,
+              Key::A, Key::S, Key::D, Key::F, Key::G, Key::H, Key::J, Key::K, Key::L,
+              Key::Z, Key::X, Key::C, Key::V, Key::B, Key::N, Key::M },
+  QList<Key>{ Key::INSERT, Key::HOME, Key::PAGE_UP, Key::KEYBOARD_DELETE, Key::END, Key::PAGE_DOWN },
+  QList<Key>{ Key::NUM_LOCK, Key::NUM_SLASH, Key::NUM_ASTERISK, Key::NUM_MINUS, Key::NUM_SEVEN, Key::NUM_EIGHT, Key::NUM_NINE,
+              Key::NUM_PLUS, Key::NUM_FOUR, Key::NUM_FIVE, Key::NUM_SIX, Key::NUM_ONE, Key::NUM_TWO, Key::NUM_THREE,
+              Key::NUM_ENTER, Key::NUM_ZERO, Key::NUM_PERIOD }
+};
+
+const std::array<const char *, LogiLED::ZONE_COUNT> ZONE_NAMES{ "Function keys", "Number keys", "Letter keys", "Navigation keys", "Numeric keypad" };
 
 //--------------------------------------------------------------------
 LogiLED::LogiLED()
-: m_available{LogiLedInitWithName("MultiAlarm")}
-, m_current  {0}
+: m_device   {LedDevice::create()}
+, m_available{m_device->initialize()}
+, m_batch    {0}
+, m_changed  {false}
+, m_version  {m_device->version()}
+, m_published{}
+, m_worker   {nullptr}
 {
+  m_published.restore = true;
+
+  // only the function keys show the items by default.
+  m_zones.fill(ZoneState{Binding::NONE, QString(), -1});
+  m_zones[static_cast<int>(Zone::FUNCTION_KEYS)].binding = Binding::ROTATION;
+
+  m_flash.setSingleShot(true);
+  m_flash.setInterval(FLASH_DURATION);
+
+  connect(&m_flash, SIGNAL(timeout()),
+          this,     SLOT(endFlash()));
+
+  m_rotation.setInterval(ROTATION_INTERVAL);
+
+  connect(&m_rotation, SIGNAL(timeout()),
+          this,        SLOT(updateLights()));
+
+  m_clock.start();
+
   if(m_available)
-    LogiLedSetTargetDevice(LOGI_DEVICETYPE_PERKEY_RGB);
+  {
+    m_worker = new LedWorker(m_device.get(), m_mailbox);
+    m_worker->moveToThread(&m_thread);
+
+    connect(&m_thread, SIGNAL(finished()),
+            m_worker,  SLOT(deleteLater()));
+
+    m_thread.start();
+  }
 }
 
 //--------------------------------------------------------------------
 LogiLED::~LogiLED()
 {
-  LogiLedShutdown();
+  finish();
+}
+
+//--------------------------------------------------------------------
+void LogiLED::finish()
+{
+  {
+    QWriteLocker lock(&m_lock);
+    if(!m_available) return;
+
+    m_available = false;
+  }
+
+  m_flash.stop();
+  m_rotation.stop();
+
+  // the frames already published are written before the thread ends.
+  m_thread.quit();
+  m_thread.wait();
+
+  m_device->shutdown();
 }
 
 //--------------------------------------------------------------------
@@ -72,23 +145,36 @@ bool LogiLED::isAvailable()
 }
 
 //--------------------------------------------------------------------
-bool LogiLED::registerItem(const QString& id, const int progress, const QColor& foreground, const QColor& background)
+bool LogiLED::registerItem(const QString& id, const int progress, const QColor& foreground, const QColor& background, const QString &group)
 {
   if(m_available)
   {
-    const Item item{id, progress, foreground, background};
-    int isEmpty = true;
-    {
-      QWriteLocker lock(&m_lock);
-      isEmpty = m_items.isEmpty();
+    QWriteLocker lock(&m_lock);
+    if(m_slots.contains(id)) return false;
 
-      if(!m_items.contains(item))
-        m_items << item;
+    // a new item starts even with the others in the rotation, not owed the time they have been shown.
+    double pass = m_slots.isEmpty() ? 0 : std::numeric_limits<double>::max();
+    for(auto slot: m_slots)
+      pass = std::min(pass, m_items.at(slot).pass);
+
+    const Item item{id, progress, foreground, background, group, -1, pass};
+    int slot;
+    if(m_free.isEmpty())
+    {
+      slot = m_items.size();
+      m_items << item;
     }
+    else
+    {
+      slot = m_free.takeLast();
+      m_items[slot] = item;
+    }
+    m_slots.insert(id, slot);
 
-    // only start updating lights when inserting the first
-    if (isEmpty)
-      updateLights();
+    if(m_batch > 0)
+      m_changed = true;
+    else
+      showItems(false);
 
     return true;
   }
@@ -102,18 +188,50 @@ bool LogiLED::unregisterItem(const QString& id)
   {
     QWriteLocker lock(&m_lock);
 
-    for(const auto &item: m_items)
-    {
-      if(item.id == id)
-      {
-        m_items.removeAll(item);
+    const auto it = m_slots.constFind(id);
+    if(it == m_slots.cend()) return false;
 
-        if(m_items.isEmpty())
-          restart();
+    // the slot is freed but not removed, the slots of the other items don't change.
+    const auto slot = it.value();
+    m_slots.erase(it);
+    m_items[slot] = Item{};
+    m_free << slot;
 
-        return true;
-      }
+    for(auto &zone: m_zones)
+    {
+      if(zone.current == slot) zone.current = -1;
     }
+
+    if(m_slots.isEmpty())
+    {
+      m_items.clear();
+      m_free.clear();
+    }
+
+    if(m_batch > 0)
+      m_changed = true;
+    else
+      showItems(false);
+
+    return true;
+  }
+
+  return false;
+}
+
+//--------------------------------------------------------------------
+bool LogiLED::setItemDeadline(const QString &id, const long long seconds)
+{
+  if(m_available)
+  {
+    QWriteLocker lock(&m_lock);
+
+    const auto slot = m_slots.value(id, -1);
+    if(slot == -1) return false;
+
+    m_items[slot].deadline = seconds < 0 ? -1 : m_clock.elapsed() + seconds * 1000;
+
+    return true;
   }
 
   return false;
@@ -126,87 +244,334 @@ bool LogiLED::updateItem(const QString& id, const int progress, const QColor& fo
   {
     QWriteLocker lock(&m_lock);
 
-    for(int i = 0; i < m_items.size(); ++i)
-    {
-      auto item = m_items.at(i);
+    const auto slot = m_slots.value(id, -1);
+    if(slot == -1) return false;
 
-      if(item.id == id)
-      {
-        item.progress = progress;
-        if(foreground != QColor()) item.foreground = foreground;
-        if(background != QColor()) item.background = background;
+    auto &item = m_items[slot];
+    item.progress = progress;
+    if(foreground != QColor()) item.foreground = foreground;
+    if(background != QColor()) item.background = background;
 
-        if(m_current == i || item.id == "NewAlarm")
-          changeKeysToColor(item.progress, item.foreground, item.background);
+    // the preview of the new alarm dialog is shown at once, in the zones of the rotation.
+    bool shown = false;
+    for(auto &zone: m_zones)
+    {
+      if(item.id == NEW_ALARM && zone.binding == Binding::ROTATION)
+        zone.current = slot;
 
-        return true;
-      }
+      shown |= zone.current == slot;
     }
+
+    if(shown)
+      drawZones(PROGRESS_FADE);
+
+    return true;
   }
 
   return false;
 }
 
 //--------------------------------------------------------------------
-void LogiLED::updateLights()
+bool LogiLED::isBound(const Item &item) const
 {
-  QReadLocker lock(&m_lock);
+  return std::any_of(m_zones.cbegin(), m_zones.cend(), [&item](const ZoneState &zone)
+  {
+    return (zone.binding == Binding::ALARM && zone.target == item.id) ||
+           (zone.binding == Binding::GROUP && !item.group.isEmpty() && zone.target == item.group);
+  });
+}
+
+//--------------------------------------------------------------------
+QList<int> LogiLED::zoneSlots(const int zone) const
+{
+  const auto &state = m_zones.at(zone);
+
+  QList<int> result;
+  for(auto slot: m_slots)
+  {
+    const auto &item = m_items.at(slot);
+
+    switch(state.binding)
+    {
+      case Binding::ROTATION:
+        if(!isBound(item)) result << slot;
+        break;
+      case Binding::ALARM:
+        if(item.id == state.target) result << slot;
+        break;
+      case Binding::GROUP:
+        if(!item.group.isEmpty() && item.group == state.target) result << slot;
+        break;
+      default:
+        break;
+    }
+  }
+
+  return result;
+}
+
+//--------------------------------------------------------------------
+int LogiLED::scheduleNext(const QList<int> &candidates, QSet<int> &advanced)
+{
+  const auto now = m_clock.elapsed();
+  auto remaining = [now](const Item &item)
+  {
+    return item.deadline < 0 ? MAX_REMAINING : std::max<qint64>(0, item.deadline - now) / 1000.;
+  };
+
+  // the items about to reach their deadline take the zone, shared between them.
+  bool takeover = false;
+  for(auto slot: candidates)
+    takeover |= remaining(m_items.at(slot)) <= TAKEOVER_TIME;
+
+  // stride scheduling, the item behind in the rotation is shown and advances inversely to its urgency.
+  int next = -1;
+  for(auto slot: candidates)
+  {
+    const auto &item = m_items.at(slot);
+    if(takeover && remaining(item) > TAKEOVER_TIME) continue;
+
+    if(next == -1 || item.pass < m_items.at(next).pass || (item.pass == m_items.at(next).pass && slot < next))
+      next = slot;
+  }
+
+  // an item shown in several zones advances once per step, not once per zone.
+  if(!advanced.contains(next))
+  {
+    auto &item = m_items[next];
+    item.pass += std::sqrt(std::clamp(remaining(item), TAKEOVER_TIME, MAX_REMAINING));
+    advanced.insert(next);
+  }
+
+  return next;
+}
 
-  if(m_available && !m_items.isEmpty())
+//--------------------------------------------------------------------
+void LogiLED::showItems(const bool next)
+{
+  bool shown = false;
+  bool rotating = false;
+  QSet<int> advanced;
+
+  for(int i = 0; i < ZONE_COUNT; ++i)
   {
-    ++m_current;
-    m_current = m_current % m_items.size();
-    auto &item = m_items.at(m_current);
+    auto &zone = m_zones[i];
 
-    changeKeysToColor(item.progress, item.foreground, item.background);
+    const auto candidates = zoneSlots(i);
+    if(candidates.isEmpty())
+    {
+      zone.current = -1;
+      continue;
+    }
 
-    QTimer::singleShot(5000, this, SLOT(updateLights()));
+    if(next || !candidates.contains(zone.current))
+      zone.current = scheduleNext(candidates, advanced);
+
+    shown = true;
+    rotating |= candidates.size() > 1;
   }
+
+  // a zone with a single item shows it until another is registered.
+  if(!rotating)
+    m_rotation.stop();
+  else
+    if(!m_rotation.isActive()) m_rotation.start();
+
+  if(shown)
+    drawZones(ALARM_FADE);
+  else
+    restart();
+}
+
+//--------------------------------------------------------------------
+void LogiLED::updateLights()
+{
+  QWriteLocker lock(&m_lock);
+
+  if(m_available)
+    showItems(true);
+}
+
+//--------------------------------------------------------------------
+void LogiLED::beginBatch()
+{
+  QWriteLocker lock(&m_lock);
+  ++m_batch;
 }
 
 //--------------------------------------------------------------------
-void LogiLED::restart() const
+void LogiLED::endBatch()
 {
+  QWriteLocker lock(&m_lock);
+
+  if(m_batch == 0 || --m_batch > 0 || !m_changed) return;
+  m_changed = false;
+
   if(m_available)
+    showItems(false);
+}
+
+//--------------------------------------------------------------------
+void LogiLED::restart()
+{
+  // the flash restores the lights when finished if there is nothing to show.
+  if(m_available && !m_flash.isActive())
   {
     // Apparently this is the only way to restore the default profile of the user, as there is no way
     // in the Logitech SDK to get the keys color (for us to store state) and the methods in the SDK
     // to store that info just don't work.
-    LogiLedShutdown();
-    LogiLedInitWithName("MultiAlarm");
+    LedFrame frame{};
+    frame.restore = true;
+
+    publish(frame);
   }
 }
 
 //--------------------------------------------------------------------
-void LogiLED::changeKeysToColor(const int progress, const QColor foreground, const QColor background)
+void LogiLED::publish(const LedFrame &frame)
+{
+  // a tic without a visible change costs nothing. The initial frame is a restore one, so the
+  // first frame of colors is always published.
+  if(frame == m_published) return;
+  m_published = frame;
+
+  // the LED thread is only woken up if it has taken the previous frame.
+  if(m_mailbox.publish(frame))
+    m_worker->wake();
+}
+
+//--------------------------------------------------------------------
+void LogiLED::drawKeys(LedFrame &frame, const QList<LedDevice::Key> &keys, const int progress, const QColor foreground, const QColor background)
 {
-  const double KEY_PERCENT = 100./KEYS.size();
+  if(keys.isEmpty()) return;
+
+  const double KEY_PERCENT = 100./keys.size();
+
+  // the colors are converted to the [0,255] values of the bitmap once, not for every key.
+  const int fg[3]{foreground.blue(), foreground.green(), foreground.red()};
+  const int bg[3]{background.blue(), background.green(), background.red()};
 
   double dProgress = progress;
 
-  for(auto it = KEYS.begin(); it != KEYS.end(); ++it, dProgress -= KEY_PERCENT)
+  for(auto it = keys.cbegin(); it != keys.cend(); ++it, dProgress -= KEY_PERCENT)
   {
     auto key = *it;
     if(dProgress < 0) dProgress = 0;
     auto percent = dProgress > KEY_PERCENT ? 1 : dProgress/KEY_PERCENT;
-    LogiLedSetLightingForKeyWithKeyName(key, 100 * (foreground.redF() * percent + background.redF() * (1-percent)),
-                                             100 * (foreground.greenF() * percent + background.greenF() * (1-percent)),
-                                             100 * (foreground.blueF() * percent + background.blueF() * (1-percent)));
+
+    // BGRA pixel of the key.
+    auto pixel = frame.bitmap.data() + LedDevice::bitmapOffset(key);
+    for(int component: {0, 1, 2})
+      pixel[component] = static_cast<quint8>(qRound(bg[component] + (fg[component] - bg[component]) * percent));
+    pixel[3] = 255;
+
+    frame.used[static_cast<int>(key)] = true;
   }
+}
+
+//--------------------------------------------------------------------
+void LogiLED::drawZones(const int fade)
+{
+  // the flash keeps the keyboard until finished.
+  if(m_flash.isActive()) return;
+
+  // all the zones in a single frame, one device call whatever the number of zones.
+  LedFrame frame{};
+  for(int i = 0; i < ZONE_COUNT; ++i)
+  {
+    const auto current = m_zones.at(i).current;
+    if(current < 0) continue;
 
+    const auto &item = m_items.at(current);
+    drawKeys(frame, ZONE_KEYS.at(i), item.progress, item.foreground, item.background);
+  }
+  frame.fade = fade;
+
+  publish(frame);
 }
 
 //--------------------------------------------------------------------
-std::string LogiLED::version() const
+void LogiLED::flash(const QColor &color)
+{
+  QWriteLocker lock(&m_lock);
+  if(!m_available) return;
+
+  LedFrame frame{};
+  for(int i = 0; i < ZONE_COUNT; ++i)
+  {
+    if(m_zones.at(i).binding != Binding::NONE)
+      drawKeys(frame, ZONE_KEYS.at(i), 100, color, color);
+  }
+
+  if(std::none_of(frame.used.cbegin(), frame.used.cend(), [](bool used) { return used; })) return;
+
+  frame.flash = true;
+  publish(frame);
+
+  m_flash.start();
+}
+
+//--------------------------------------------------------------------
+void LogiLED::endFlash()
 {
-  int major, minor, build;
-  LogiLedGetSdkVersion(&major, &minor, &build);
+  QWriteLocker lock(&m_lock);
+
+  if(m_available && m_batch == 0)
+    showItems(false);
+}
 
-  return std::to_string(major) + "." + std::to_string(minor) + "." + std::to_string(build);
+//--------------------------------------------------------------------
+void LogiLED::setFrameRate(const int fps)
+{
+  if(m_worker)
+    m_worker->setFrameRate(fps);
 }
 
 //--------------------------------------------------------------------
-bool operator==(const LogiLED::Item &rhs, const LogiLED::Item &lhs)
+QString LogiLED::zoneName(const Zone zone)
+{
+  return QString(ZONE_NAMES.at(static_cast<int>(zone)));
+}
+
+//--------------------------------------------------------------------
+QList<LedDevice::Key> LogiLED::zoneKeys(const Zone zone)
+{
+  return ZONE_KEYS.at(static_cast<int>(zone));
+}
+
+//--------------------------------------------------------------------
+void LogiLED::setZoneBinding(const Zone zone, const Binding binding, const QString &target)
+{
+  QWriteLocker lock(&m_lock);
+
+  auto &state = m_zones[static_cast<int>(zone)];
+  state.binding = binding;
+  state.target  = (binding == Binding::ALARM || binding == Binding::GROUP) ? target : QString();
+
+  // the items of the other zones may change too, a bound alarm leaves the rotation.
+  for(auto &other: m_zones)
+    other.current = -1;
+
+  if(m_available && m_batch == 0)
+    showItems(false);
+}
+
+//--------------------------------------------------------------------
+LogiLED::Binding LogiLED::zoneBinding(const Zone zone) const
+{
+  QReadLocker lock(&m_lock);
+  return m_zones.at(static_cast<int>(zone)).binding;
+}
+
+//--------------------------------------------------------------------
+QString LogiLED::zoneTarget(const Zone zone) const
+{
+  QReadLocker lock(&m_lock);
+  return m_zones.at(static_cast<int>(zone)).target;
+}
+
+//--------------------------------------------------------------------
+std::string LogiLED::version() const
 {
-  return rhs.id == lhs.id;
+  return m_version;
 }
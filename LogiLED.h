@@ -20,17 +20,33 @@
 #ifndef LOGILED_H_
 #define LOGILED_H_
 
+// Project
+#include <LedDevice.h>
+#include <LedFrame.h>
+
 // C++
+#include <array>
 #include <memory>
 
 // Qt
 #include <QObject>
 #include <QString>
 #include <QColor>
+#include <QHash>
+#include <QSet>
 #include <QReadWriteLock>
+#include <QThread>
+#include <QTimer>
+#include <QElapsedTimer>
+
+class LedWorker;
 
 /** \class LogiLED
- * \brief Interface to Logitech Gaming LED SDK
+ * \brief Shows the progress of the alarms in the keyboard lights, through the LedDevice backend. The
+ *        GUI thread only publishes the desired keyboard frame, the device is written from the LED thread.
+ *
+ *        The keyboard is divided in zones, each showing an alarm, the alarms of a group or the rotation of
+ *        the alarms not shown in other zones. All the zones are composed in a single frame.
  *
  */
 class LogiLED
@@ -38,6 +54,19 @@ class LogiLED
 {
     Q_OBJECT
   public:
+    /** \brief Keyboard zones.
+     *
+     */
+    enum class Zone: quint8 { FUNCTION_KEYS = 0, NUMBER_KEYS, LETTER_KEYS, NAVIGATION_KEYS, NUMERIC_KEYPAD };
+
+    static constexpr int ZONE_COUNT = 5; /** number of keyboard zones. */
+
+    /** \brief Items shown in a zone: none, keeping the lighting of the user, the rotation of the items not
+     *         bound to other zones, the item of an alarm, or the rotation of the items of a group.
+     *
+     */
+    enum class Binding: quint8 { NONE = 0, ROTATION, ALARM, GROUP };
+
     /** \brief LogiLED class virtual destructor.
      *
      */
@@ -68,9 +97,18 @@ class LogiLED
      * \param[in] progress Progress value in [0,100].
      * \param[in] foreground Foreground color.
      * \param[in] background Background color.
+     * \param[in] group Group of the item, empty if none.
+     *
+     */
+    bool registerItem(const QString &id, const int progress, const QColor &foreground, const QColor &background, const QString &group = QString());
+
+    /** \brief Sets the time to the deadline of an item, the nearer the longer it's shown. Returns true on
+     *         success and false if the item couldn't be found.
+     * \param[in] id Item identifier.
+     * \param[in] seconds Seconds to the deadline, -1 if unknown or paused.
      *
      */
-    bool registerItem(const QString &id, const int progress, const QColor &foreground, const QColor &background);
+    bool setItemDeadline(const QString &id, const long long seconds);
 
     /** \brief Unregisters an item. Returns true on success and false if the item couldn't be found.
      * \param[in] id Item identifier.
@@ -87,18 +125,116 @@ class LogiLED
      */
     bool updateItem(const QString &id, const int progress, const QColor &foreground = QColor(), const QColor &background = QColor());
 
+    /** \brief Starts a batch of changes. Keyboard updates are deferred until the matching endBatch() call.
+     *
+     */
+    void beginBatch();
+
+    /** \brief Ends a batch of changes and updates the keyboard lights once if the items changed.
+     *
+     */
+    void endBatch();
+
     /** \brief Returns the Logitech library version string. 
      *
      */
     std::string version() const;
 
+    /** \brief Returns the name of the keyboard zone.
+     * \param[in] zone keyboard zone.
+     *
+     */
+    static QString zoneName(const Zone zone);
+
+    /** \brief Returns the keys of the keyboard zone, in the order they fill with the progress.
+     * \param[in] zone keyboard zone.
+     *
+     */
+    static QList<LedDevice::Key> zoneKeys(const Zone zone);
+
+    /** \brief Sets the items shown in the keyboard zone. Only the function keys show the items, in rotation,
+     *         by default.
+     * \param[in] zone keyboard zone.
+     * \param[in] binding items shown in the zone.
+     * \param[in] target alarm or group name for ALARM and GROUP bindings, ignored otherwise.
+     *
+     */
+    void setZoneBinding(const Zone zone, const Binding binding, const QString &target = QString());
+
+    /** \brief Returns the items shown in the keyboard zone.
+     * \param[in] zone keyboard zone.
+     *
+     */
+    Binding zoneBinding(const Zone zone) const;
+
+    /** \brief Returns the alarm or group name shown in the keyboard zone, empty if not bound to one.
+     * \param[in] zone keyboard zone.
+     *
+     */
+    QString zoneTarget(const Zone zone) const;
+
+    /** \brief Flashes the keys of the zones in use in the given color for a few seconds, then shows the items again.
+     * \param[in] color flash color.
+     *
+     */
+    void flash(const QColor &color);
+
+    /** \brief Sets the maximum number of frames per second of the keyboard lights animations.
+     * \param[in] fps frames per second, 0 to show the changes at once without animations.
+     *
+     */
+    void setFrameRate(const int fps);
+
+    /** \brief Returns the keyboard lights backend.
+     *
+     */
+    LedDevice *device() const
+    { return m_device.get(); }
+
+    /** \brief Stops the LED thread and ends the session with the device, restoring the lighting of the
+     *         user. Must be called before the application is destroyed.
+     *
+     */
+    void finish();
+
   private slots:
-    /** \brief Updates the keyboard lights.
+    /** \brief Shows the next item in the rotation.
      *
      */
     void updateLights();
 
+    /** \brief Shows the items of the zones, or restores the lights if there is nothing to show, when the flash ends.
+     *
+     */
+    void endFlash();
+
   private:
+    /** \struct Item
+     * \brief Holds internal data for a registered item.
+     *
+     */
+    struct Item
+    {
+      QString id;         /** item identifier, empty if the slot is free. */
+      int     progress;   /** progress value in [0,100].                  */
+      QColor  foreground; /** background color for keys.                  */
+      QColor  background; /** foreground color for keys.                  */
+      QString group;      /** group of the item, empty if none.           */
+      qint64  deadline;   /** deadline in the clock milliseconds, or -1.  */
+      double  pass;       /** rotation position, lowest shown next.       */
+    };
+
+    /** \struct ZoneState
+     * \brief Holds the binding and the item shown of a keyboard zone.
+     *
+     */
+    struct ZoneState
+    {
+      Binding binding; /** items shown in the zone.            */
+      QString target;  /** alarm or group name of the binding. */
+      int     current; /** slot of the item shown, -1 if none. */
+    };
+
     /** \brief LogilLED class private constructor.
      *
      */
@@ -113,50 +249,76 @@ class LogiLED
     /** \brief Shutdowns and re-initializes the session to restore default keyboard lights.
      *
      */
-    void restart() const;
+    void restart();
+
+    /** \brief Publishes the frame to the LED thread.
+     * \param[in] frame keyboard frame.
+     *
+     */
+    void publish(const LedFrame &frame);
 
-    /** \brief Changes the keys to the given parameters.
+    /** \brief Fills the keys of the frame with the given parameters.
+     * \param[inout] frame keyboard frame.
+     * \param[in] keys keys to fill, in order.
      * \param[in] progress Value in [0,100].
      * \param[in] foreground Foreground color.
      * \param[in] background Background color.
      *
      */
-    void changeKeysToColor(const int progress, const QColor foreground, const QColor background);
+    static void drawKeys(LedFrame &frame, const QList<LedDevice::Key> &keys, const int progress, const QColor foreground, const QColor background);
 
-    /** \struct Item
-     * \brief Holds internal data for a registered item.
+    /** \brief Publishes the frame of the items shown in the zones, unless the keys are flashing. Must be
+     *         called with the lock held.
+     * \param[in] fade Milliseconds to fade from the current colors.
      *
      */
-    struct Item
-    {
-      QString id;         /** item identifier.           */
-      int     progress;   /** progress value in [0,100]. */
-      QColor  foreground; /** background color for keys. */
-      QColor  background; /** foreground color for keys. */
-
-      /** \brief Item constructor.
-       * \param[in] i Item identifier.
-       * \param[in] p Progress value in [0,100]
-       * \param[in] f Foreground color.
-       * \param[in] b Background color.
-       *
-       */
-      Item(const QString &i, const int p, const QColor &f, const QColor &b): id(i), progress(p), foreground(f), background(b) {};
-    };
+    void drawZones(const int fade);
 
-    bool               m_available; /** true if the LogiLED API is available and initialized. */
-    QList<struct Item> m_items;     /** list of registered items to show in the keyboard.     */
-    int                m_current;   /** index to current item showing.                        */
-    QReadWriteLock     m_lock;      /** data protection mutex.                                */
+    /** \brief Returns the slots of the items that can be shown in the zone. Must be called with the lock held.
+     * \param[in] zone zone index.
+     *
+     */
+    QList<int> zoneSlots(const int zone) const;
 
-    friend bool operator==(const LogiLED::Item &rhs, const LogiLED::Item &lhs);
-};
+    /** \brief Returns true if the item is bound to a zone by its alarm or group. Must be called with the lock held.
+     * \param[in] item registered item.
+     *
+     */
+    bool isBound(const Item &item) const;
 
-/** \brief Comparison operator for LogiLED items. Returns true if equal in id.
- * \param[in] rhs LogiLED struct item.
- * \param[in] lhs LogiLED struct item.
- *
- */
-bool operator==(const LogiLED::Item &rhs, const LogiLED::Item &lhs);
+    /** \brief Returns the slot of the next item to show and advances it in the rotation, unless already
+     *         advanced. The items near their deadline are shown more often, and only them if near enough.
+     *         Must be called with the lock held.
+     * \param[in] candidates slots of the candidate items, not empty.
+     * \param[inout] advanced slots already advanced in this rotation step, the returned one is added.
+     *
+     */
+    int scheduleNext(const QList<int> &candidates, QSet<int> &advanced);
+
+    /** \brief Shows the current item of each zone, or the next one, or restores the lights if there is
+     *         nothing to show. Starts the rotation if a zone has several items. Must be called with the lock held.
+     * \param[in] next true to show the next item in the rotation.
+     *
+     */
+    void showItems(const bool next);
+
+    std::unique_ptr<LedDevice>        m_device;    /** keyboard lights backend.                               */
+    bool                              m_available; /** true if the backend is available and initialized.      */
+    QList<Item>                       m_items;     /** item slots, an item keeps its slot until unregistered. */
+    QHash<QString, int>               m_slots;     /** slot index of each registered item identifier.         */
+    QList<int>                        m_free;      /** free slots, reused before growing the list.            */
+    std::array<ZoneState, ZONE_COUNT> m_zones;     /** keyboard zones.                                        */
+    mutable QReadWriteLock            m_lock;      /** data protection mutex.                                 */
+    int                               m_batch;     /** batch nesting depth, keyboard updates deferred if > 0. */
+    bool                              m_changed;   /** true if the items changed during the current batch.    */
+    std::string                       m_version;   /** backend library version.                               */
+    LedMailbox                        m_mailbox;   /** latest frame for the LED thread.                       */
+    LedFrame                          m_published; /** last frame published.                                  */
+    QTimer                            m_flash;     /** flash effect duration, active while the keys flash.    */
+    QTimer                            m_rotation;  /** zones rotation, stopped if no zone has several items.  */
+    QElapsedTimer                     m_clock;     /** clock of the items deadlines.                          */
+    QThread                           m_thread;    /** LED thread.                                            */
+    LedWorker                        *m_worker;    /** writes the frames to the device in the LED thread.     */
+};
 
 #endif // LOGILED_H_
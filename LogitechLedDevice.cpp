@@ -0,0 +1,96 @@
+/*
+ File: LogitechLedDevice.cpp
+ Created on: 19/10/2026
+ Author: Felix de las Pozas Alvarez
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Project
+#include <LogitechLedDevice.h>
+
+// Logitech gaming SDK
+extern "C"
+{
+  #include <LogitechLEDLib.h>
+}
+
+// C++
+#include <array>
+#include <vector>
+
+using namespace LogiLed;
+
+// indexed by LedDevice::Key.
+const std::array<KeyName, LedDevice::KEY_COUNT> KEY_NAMES{ ESC, F1, F2, F3, F4, F5, F6, F7, F8, F9, F10, F11, F12, PRINT_SCREEN, SCROLL_LOCK, PAUSE_BREAK, TILDE, ONE,
+                                                           TWO, THREE, FOUR, FIVE, SIX, SEVEN, EIGHT, NINE, ZERO, MINUS, EQUALS, BACKSPACE, INSERT, HOME, PAGE_UP,
+                                                           NUM_LOCK, NUM_SLASH, NUM_ASTERISK, NUM_MINUS, TAB, Q, W, E, R, T, Y, U, I, O, P, OPEN_BRACKET, CLOSE_BRACKET,
+                                                           BACKSLASH, KEYBOARD_DELETE, END, PAGE_DOWN, NUM_SEVEN, NUM_EIGHT, NUM_NINE, NUM_PLUS, CAPS_LOCK, A, S, D, F,
+                                                           G, H, J, K, L, SEMICOLON, APOSTROPHE, ENTER, NUM_FOUR, NUM_FIVE, NUM_SIX, LEFT_SHIFT, Z, X, C, V, B, N, M,
+                                                           COMMA, PERIOD, FORWARD_SLASH, RIGHT_SHIFT, ARROW_UP, NUM_ONE, NUM_TWO, NUM_THREE, NUM_ENTER, LEFT_CONTROL,
+                                                           LEFT_WINDOWS, LEFT_ALT, SPACE, RIGHT_ALT, RIGHT_WINDOWS, APPLICATION_SELECT, RIGHT_CONTROL, ARROW_LEFT,
+                                                           ARROW_DOWN, ARROW_RIGHT, NUM_ZERO, NUM_PERIOD };
+
+//-----------------------------------------------------------------
+LogitechLedDevice::~LogitechLedDevice()
+{
+  shutdown();
+}
+
+//-----------------------------------------------------------------
+bool LogitechLedDevice::initialize()
+{
+  if(!LogiLedInitWithName("MultiAlarm")) return false;
+
+  LogiLedSetTargetDevice(LOGI_DEVICETYPE_PERKEY_RGB);
+
+  return true;
+}
+
+//-----------------------------------------------------------------
+void LogitechLedDevice::shutdown()
+{
+  LogiLedShutdown();
+}
+
+//-----------------------------------------------------------------
+bool LogitechLedDevice::setBitmap(const Bitmap &bitmap)
+{
+  static_assert(BITMAP_SIZE == LOGI_LED_BITMAP_SIZE, "Keyboard bitmap doesn't match the SDK one.");
+
+  // the SDK doesn't modify the bitmap, it just isn't declared const.
+  return LogiLedSetLightingFromBitmap(const_cast<unsigned char *>(bitmap.data()));
+}
+
+//-----------------------------------------------------------------
+bool LogitechLedDevice::excludeKeys(const QList<Key> &keys)
+{
+  if(keys.isEmpty()) return true;
+
+  std::vector<KeyName> names;
+  names.reserve(keys.size());
+  for(const auto key: keys)
+    names.push_back(KEY_NAMES.at(static_cast<int>(key)));
+
+  return LogiLedExcludeKeysFromBitmap(names.data(), static_cast<int>(names.size()));
+}
+
+//-----------------------------------------------------------------
+std::string LogitechLedDevice::version() const
+{
+  int major, minor, build;
+  LogiLedGetSdkVersion(&major, &minor, &build);
+
+  return std::to_string(major) + "." + std::to_string(minor) + "." + std::to_string(build);
+}
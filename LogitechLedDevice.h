@@ -0,0 +1,53 @@
+/*
+ File: LogitechLedDevice.h
+ Created on: 19/10/2026
+ Author: Felix de las Pozas Alvarez
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LOGITECHLEDDEVICE_H_
+#define LOGITECHLEDDEVICE_H_
+
+// Project
+#include <LedDevice.h>
+
+/** \class LogitechLedDevice
+ * \brief Keyboard lights backend of the Logitech Gaming LED SDK. Only built with USE_LOGITECH_SDK.
+ *
+ */
+class LogitechLedDevice
+: public LedDevice
+{
+  public:
+    /** \brief LogitechLedDevice class virtual destructor.
+     *
+     */
+    virtual ~LogitechLedDevice();
+
+    virtual bool initialize() override;
+
+    virtual void shutdown() override;
+
+    virtual bool setBitmap(const Bitmap &bitmap) override;
+
+    virtual bool excludeKeys(const QList<Key> &keys) override;
+
+    virtual std::string version() const override;
+
+    virtual QString name() const override
+    { return "logitech"; }
+};
+
+#endif // LOGITECHLEDDEVICE_H_
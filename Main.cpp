@@ -25,6 +25,7 @@
 #include <QSharedMemory>
 #include <QMessageBox>
 #include <QIcon>
+#include <QCommandLineParser>
 
 // C++
 #include <iostream>
@@ -47,11 +48,30 @@ int main(int argc, char *argv[])
 	QApplication app(argc, argv);
 	app.setQuitOnLastWindowClosed(false);
 
+	QCommandLineParser parser;
+	parser.setApplicationDescription("Multiple alarms and timers. Importing or exporting alarms requires MultiAlarm not to be running.");
+	parser.addHelpOption();
+
+	const QCommandLineOption importOption({"i", "import"}, "Imports the alarms of the JSON <file>.", "file");
+	const QCommandLineOption exportOption({"e", "export"}, "Exports the alarms to the JSON <file>.", "file");
+	const QCommandLineOption quitOption({"q", "quit"}, "Exits after importing or exporting the alarms.");
+	parser.addOptions({importOption, exportOption, quitOption});
+	parser.process(app);
+
   // allow only one instance
   QSharedMemory guard;
   guard.setKey("MultiAlarm");
 
-  if (!guard.create(1))
+	const auto running = !guard.create(1);
+
+	// the alarms of the running instance would be overwritten, a script gets an error instead of a dialog.
+	if(running && (parser.isSet(importOption) || parser.isSet(exportOption)))
+	{
+		std::cerr << "MultiAlarm is already running, close it before importing or exporting alarms." << std::endl;
+		return 1;
+	}
+
+  if (running)
   {
     QMessageBox msgBox;
     msgBox.setWindowIcon(QIcon(":/MultiAlarm/application.ico"));
@@ -63,6 +83,34 @@ int main(int argc, char *argv[])
   }
 
 	MultiAlarm alarm;
+
+	int errorValue = 0;
+
+	if(parser.isSet(importOption))
+	{
+		QStringList errors;
+		const auto imported = alarm.importJson(parser.value(importOption), errors);
+
+		for(const auto &error: errors)
+			std::cerr << error.toStdString() << std::endl;
+
+		std::cout << "Imported " << imported << " alarms." << std::endl;
+		if(!errors.isEmpty()) errorValue = 1;
+	}
+
+	if(parser.isSet(exportOption))
+	{
+		QString error;
+		if(!alarm.exportJson(parser.value(exportOption), error))
+		{
+			std::cerr << error.toStdString() << std::endl;
+			errorValue = 1;
+		}
+	}
+
+	// the alarms are written to the store on exit, before any dialog is shown.
+	if(parser.isSet(quitOption)) return errorValue;
+
 	alarm.show();
 
 	auto resultValue = app.exec();
@@ -0,0 +1,97 @@
+/*
+ File: MockLedDevice.cpp
+ Created on: 19/10/2026
+ Author: Felix de las Pozas Alvarez
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Project
+#include <MockLedDevice.h>
+
+//-----------------------------------------------------------------
+MockLedDevice::MockLedDevice()
+: m_restores{0}
+, m_calls   {0}
+{
+  m_timer.start();
+}
+
+//-----------------------------------------------------------------
+void MockLedDevice::restore()
+{
+  QMutexLocker lock(&m_mutex);
+  ++m_restores;
+  ++m_calls;
+
+  // restoring ends the session, and the exclusions with it.
+  m_excluded.clear();
+}
+
+//-----------------------------------------------------------------
+bool MockLedDevice::setBitmap(const Bitmap &bitmap)
+{
+  QMutexLocker lock(&m_mutex);
+  m_bitmaps << BitmapWrite{m_timer.nsecsElapsed(), bitmap};
+  ++m_calls;
+
+  return true;
+}
+
+//-----------------------------------------------------------------
+bool MockLedDevice::excludeKeys(const QList<Key> &keys)
+{
+  QMutexLocker lock(&m_mutex);
+  m_excluded << keys;
+  ++m_calls;
+
+  return true;
+}
+
+//-----------------------------------------------------------------
+QList<MockLedDevice::BitmapWrite> MockLedDevice::bitmaps() const
+{
+  QMutexLocker lock(&m_mutex);
+  return m_bitmaps;
+}
+
+//-----------------------------------------------------------------
+QList<LedDevice::Key> MockLedDevice::excluded() const
+{
+  QMutexLocker lock(&m_mutex);
+  return m_excluded;
+}
+
+//-----------------------------------------------------------------
+int MockLedDevice::calls() const
+{
+  QMutexLocker lock(&m_mutex);
+  return m_calls;
+}
+
+//-----------------------------------------------------------------
+int MockLedDevice::restores() const
+{
+  QMutexLocker lock(&m_mutex);
+  return m_restores;
+}
+
+//-----------------------------------------------------------------
+void MockLedDevice::clear()
+{
+  QMutexLocker lock(&m_mutex);
+  m_bitmaps.clear();
+  m_restores = 0;
+  m_calls = 0;
+}
@@ -0,0 +1,115 @@
+/*
+ File: MockLedDevice.h
+ Created on: 19/10/2026
+ Author: Felix de las Pozas Alvarez
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MOCKLEDDEVICE_H_
+#define MOCKLEDDEVICE_H_
+
+// Project
+#include <LedDevice.h>
+
+// Qt
+#include <QList>
+#include <QMutex>
+#include <QElapsedTimer>
+
+/** \class MockLedDevice
+ * \brief Keyboard lights backend without device that records every write, to measure the number and
+ *        frequency of the updates without a keyboard. Always available. Each call is a device call.
+ *
+ *        The writes can be read from any thread.
+ *
+ */
+class MockLedDevice
+: public LedDevice
+{
+  public:
+    /** \struct BitmapWrite
+     * \brief Keyboard bitmap write.
+     *
+     */
+    struct BitmapWrite
+    {
+      qint64 time;   /** nanoseconds since the device was created. */
+      Bitmap bitmap; /** keyboard bitmap.                          */
+    };
+
+    /** \brief MockLedDevice class constructor.
+     *
+     */
+    MockLedDevice();
+
+    /** \brief MockLedDevice class virtual destructor.
+     *
+     */
+    virtual ~MockLedDevice()
+    {};
+
+    virtual bool initialize() override
+    { return true; }
+
+    virtual void shutdown() override
+    {};
+
+    virtual void restore() override;
+
+    virtual bool setBitmap(const Bitmap &bitmap) override;
+
+    virtual bool excludeKeys(const QList<Key> &keys) override;
+
+    virtual std::string version() const override
+    { return "mock"; }
+
+    virtual QString name() const override
+    { return "mock"; }
+
+    /** \brief Returns the recorded bitmap writes.
+     *
+     */
+    QList<BitmapWrite> bitmaps() const;
+
+    /** \brief Returns the keys currently excluded from the bitmaps.
+     *
+     */
+    QList<Key> excluded() const;
+
+    /** \brief Returns the total number of device calls.
+     *
+     */
+    int calls() const;
+
+    /** \brief Returns the number of times the lighting of the user has been restored.
+     *
+     */
+    int restores() const;
+
+    /** \brief Removes the recorded bitmap writes, restores and calls.
+     *
+     */
+    void clear();
+
+  private:
+    QElapsedTimer      m_timer;    /** time since creation.                     */
+    QList<BitmapWrite> m_bitmaps;  /** recorded bitmap writes.                  */
+    QList<Key>         m_excluded; /** keys excluded from the bitmaps.          */
+    int                m_restores; /** number of restores of the user lighting. */
+    int                m_calls;    /** number of device calls.                  */
+    mutable QMutex     m_mutex;    /** protects the recorded data.              */
+};
+
+#endif // MOCKLEDDEVICE_H_
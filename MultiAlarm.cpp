@@ -22,45 +22,64 @@
 #include <AboutDialog.h>
 #include <NewAlarmDialog.h>
 #include <LogiLED.h>
+#include <SoundBank.h>
+#include <SoundMixer.h>
 #include <Alarm.h>
+#include <AlarmStore.h>
+#include <AlarmJson.h>
+#include <Utils.h>
 
 // Qt
 #include <QCloseEvent>
 #include <QAction>
 #include <QMenu>
+#include <QActionGroup>
 #include <QMessageBox>
 #include <QScrollBar>
 #include <QDir>
+#include <QThread>
+#include <QStandardPaths>
+#include <QFileDialog>
+#include <QSaveFile>
+#include <QSet>
+#include <QInputDialog>
+#include <QDebug>
 
 const int MAX_HEIGHT = 800;
 const int BAR_WIDTH  = 15;
 
+const int MAX_IMPORT_ERRORS = 20;  // errors shown after an import.
+const int RELOAD_DELAY      = 500; // milliseconds after an external store change to reload it.
+
 const QString STATE    = "State";
 const QString GEOMETRY = "Geometry";
-const QString ALARMS   = "Alarms";
-
-const QString ALARM_NAME            = "Name";
-const QString ALARM_MESSAGE         = "Message";
-const QString ALARM_COLOR           = "Color";
-const QString ALARM_IS_TIMER        = "Timer";
-const QString ALARM_TIMER_LOOP      = "Loops";
-const QString ALARM_TIMER_TIME      = "TimerTime";
-const QString ALARM_CLOCK_DATETIME  = "ClockDateTime";
-const QString ALARM_SOUND           = "Sound";
-const QString ALARM_SOUND_VOLUME    = "SoundVolume";
-const QString ALARM_USE_TRAY        = "UseTray";
-const QString ALARM_USE_DESKTOP     = "UseDesktop";
-const QString ALARM_USE_LOGILED     = "UseLogiled";
-const QString ALARM_WIDGET_POSITION = "DesktopWidgetPosition";
-const QString ALARM_WIDGET_OPACITY  = "DesktopWidgetOpacity";
-
-const QString INI_FILENAME = "MultiAlarm.ini";
+const QString GROUPS   = "Groups";
+
+const QString SOUND_CACHE_SIZE = "SoundCacheSize"; // megabytes.
+const QString LED_FRAME_RATE   = "LedFrameRate";   // frames per second, 0 to disable the animations.
+
+const QString LED_ZONES        = "LedZones";
+const QString LED_ZONE_BINDING = "Binding";
+const QString LED_ZONE_TARGET  = "Target";
+
+const QString GROUP_COLLAPSED = "Collapsed";
+const QString GROUP_AGGREGATE = "Aggregate";
+
+const QString INI_FILENAME     = "MultiAlarm.ini";
+const QString JOURNAL_FILENAME = "MultiAlarm.journal";
+const QString BINARY_FILENAME  = "MultiAlarm.alarms";
 
 //-----------------------------------------------------------------
 MultiAlarm::MultiAlarm(QWidget *parent, Qt::WindowFlags flags)
 : QMainWindow{parent, flags}
 , m_icon     {new QSystemTrayIcon(QIcon(":/MultiAlarm/application.ico"), this)}
+, m_dialog   {nullptr}
 , m_needsExit{false}
+, m_barVisible{false}
+, m_restoring {false}
+, m_binaryStore{false}
+, m_settings  {applicationSettings()}
+, m_writer    {nullptr}
 {
   setWindowFlags(windowFlags() & ~Qt::WindowMaximizeButtonHint);
 
@@ -75,19 +94,43 @@ MultiAlarm::MultiAlarm(QWidget *parent, Qt::WindowFlags flags)
   m_scrollArea->setVerticalScrollBarPolicy(Qt::ScrollBarAsNeeded);
   m_scrollArea->verticalScrollBar()->hide();
 
+  m_reloadTimer.setSingleShot(true);
+  m_reloadTimer.setInterval(RELOAD_DELAY);
+
+  qRegisterMetaType<QList<AlarmConfiguration>>("QList<AlarmConfiguration>");
+
   restoreSettings();
 
+  // the audio output and the embedded sounds are ready before the first dialog or timeout.
+  SoundBank::getInstance().prepareAll();
+
   setupTrayIcon();
 
   LogiLED::getInstance();
 
+  setupKeyboardMenu();
+
+  // built once, opening it later only resets its values.
+  m_dialog = new NewAlarmDialog(this);
+
   connectSignals();
+
+  updateBulkActions();
 }
 
 //-----------------------------------------------------------------
 MultiAlarm::~MultiAlarm()
 {
   saveSettings();
+
+  // the only wait for the disk, pending writes are finished before exiting.
+  m_writer->finish();
+  m_writerThread.wait();
+
+  // the audio output, the decoding and LED threads can't outlive the application object.
+  SoundMixer::getInstance().clear();
+  SoundBank::getInstance().clear();
+  LogiLED::getInstance().finish();
 }
 
 //-----------------------------------------------------------------
@@ -112,20 +155,111 @@ QStringList MultiAlarm::usedColors() const
   return result;
 }
 
+//-----------------------------------------------------------------
+QStringList MultiAlarm::groupNames() const
+{
+  return m_groups.keys();
+}
+
 //-----------------------------------------------------------------
 void MultiAlarm::createNewAlarm()
 {
-  NewAlarmDialog dialog(usedNames(), usedColors(), this);
+  AlarmConfiguration defaults;
+  defaults.isTimer    = true;
+  defaults.useLogiled = LogiLED::isAvailable();
 
-  dialog.exec();
+  m_dialog->setWindowTitle(tr("Create Alarm"));
+  m_dialog->setConfiguration(defaults, usedNames(), usedColors(), groupNames());
 
-  if(dialog.result() == QDialog::Accepted)
+  if(m_dialog->exec() == QDialog::Accepted)
   {
-    auto alarmWidget = createAlarmWidget(dialog);
+    // a clock alarm can expire while the dialog is open.
+    auto alarmWidget = createAlarmWidget(m_dialog->configuration());
+    if(!alarmWidget) return;
+
     addAlarmWidget(alarmWidget);
+
+    const auto conf = alarmWidget->alarmConfiguration();
+    journal(AlarmJournal::Entry{AlarmJournal::Operation::CREATE, conf.name, conf});
   }
 }
 
+//-----------------------------------------------------------------
+void MultiAlarm::createNewAlarms()
+{
+  const auto usedColorList = usedColors();
+  const auto available = QColor::colorNames().size() - QSet<QString>(usedColorList.constBegin(), usedColorList.constEnd()).size();
+  if(available < 2)
+  {
+    QMessageBox::information(this, tr("Create Alarms"), tr("There are not enough unused colors to create several alarms."));
+    return;
+  }
+
+  bool accepted = false;
+  const auto count = QInputDialog::getInt(this, tr("Create Alarms"), tr("Number of alarms:"), 2, 2, available, 1, &accepted);
+  if(!accepted) return;
+
+  AlarmConfiguration defaults;
+  defaults.isTimer    = true;
+  defaults.useLogiled = LogiLED::isAvailable();
+
+  m_dialog->setWindowTitle(tr("Create %1 Alarms").arg(count));
+  m_dialog->setConfiguration(defaults, usedNames(), usedColorList, groupNames());
+
+  if(m_dialog->exec() == QDialog::Accepted)
+  {
+    // one layout update and one journal write for all of them.
+    insertAlarmWidgets(createAlarmWidgets(m_dialog->configuration(), count));
+  }
+}
+
+//-----------------------------------------------------------------
+QList<AlarmWidget *> MultiAlarm::createAlarmWidgets(const AlarmConfiguration &conf, int count)
+{
+  QSet<QString> names;
+  for(const auto &name: usedNames())
+    names.insert(name.toCaseFolded());
+
+  const auto usedColorList = usedColors();
+  auto colors = QSet<QString>(usedColorList.constBegin(), usedColorList.constEnd());
+
+  auto colorNames = QColor::colorNames();
+  colorNames.prepend(conf.color);
+
+  QList<AlarmWidget *> widgets;
+  auto color = colorNames.cbegin();
+  int number = 1;
+
+  auto &logiled = LogiLED::getInstance();
+  logiled.beginBatch();
+
+  while(widgets.size() < count)
+  {
+    while(color != colorNames.cend() && colors.contains(*color)) ++color;
+    if(color == colorNames.cend()) break;
+
+    auto alarm = conf;
+    do
+    {
+      alarm.name = QString("%1 %2").arg(conf.name).arg(number++);
+    }
+    while(names.contains(alarm.name.toCaseFolded()));
+
+    alarm.color = *color;
+
+    auto widget = createAlarmWidget(alarm);
+    if(!widget) break;
+
+    names.insert(alarm.name.toCaseFolded());
+    colors.insert(alarm.color);
+    widgets << widget;
+  }
+
+  logiled.endBatch();
+
+  return widgets;
+}
+
 //-----------------------------------------------------------------
 void MultiAlarm::aboutDialog()
 {
@@ -175,6 +309,102 @@ void MultiAlarm::onTrayIconActivated(QSystemTrayIcon::ActivationReason reason)
   }
 }
 
+//-----------------------------------------------------------------
+void MultiAlarm::setupKeyboardMenu()
+{
+  for(int i = 0; i < LogiLED::ZONE_COUNT; ++i)
+  {
+    auto menu = menuKeyboard->addMenu(LogiLED::zoneName(static_cast<LogiLED::Zone>(i)));
+    menu->menuAction()->setData(i);
+
+    // filled when shown, the alarms and groups change.
+    connect(menu, SIGNAL(aboutToShow()),
+            this, SLOT(onKeyboardZoneMenuAboutToShow()));
+
+    connect(menu, SIGNAL(triggered(QAction *)),
+            this, SLOT(onKeyboardZoneSelected(QAction *)));
+  }
+
+  menuKeyboard->menuAction()->setEnabled(LogiLED::isAvailable());
+}
+
+//-----------------------------------------------------------------
+void MultiAlarm::onKeyboardZoneMenuAboutToShow()
+{
+  auto menu = qobject_cast<QMenu *>(sender());
+  if(!menu) return;
+
+  const auto zone    = menu->menuAction()->data().toInt();
+  const auto binding = LogiLED::getInstance().zoneBinding(static_cast<LogiLED::Zone>(zone));
+  const auto target  = LogiLED::getInstance().zoneTarget(static_cast<LogiLED::Zone>(zone));
+
+  menu->clear();
+  auto bindings = new QActionGroup(menu);
+
+  auto addBinding = [&](const QString &text, const LogiLED::Binding value, const QString &name)
+  {
+    auto action = menu->addAction(text);
+    action->setCheckable(true);
+    action->setChecked(binding == value && target == name);
+    action->setData(QVariantList{zone, static_cast<int>(value), name});
+    bindings->addAction(action);
+  };
+
+  addBinding(tr("Off"), LogiLED::Binding::NONE, QString());
+  addBinding(tr("Alarms not shown in other zones"), LogiLED::Binding::ROTATION, QString());
+
+  if(!m_groups.isEmpty())
+    menu->addSeparator();
+
+  for(const auto &group: groupNames())
+    addBinding(tr("Group: %1").arg(group), LogiLED::Binding::GROUP, group);
+
+  // only the alarms that use the keyboard lights can be shown.
+  bool first = true;
+  for(auto alarm: m_alarms)
+  {
+    if(!alarm->alarmConfiguration().useLogiled) continue;
+
+    if(first) menu->addSeparator();
+    first = false;
+
+    addBinding(tr("Alarm: %1").arg(alarm->name()), LogiLED::Binding::ALARM, alarm->name());
+  }
+}
+
+//-----------------------------------------------------------------
+void MultiAlarm::onKeyboardZoneSelected(QAction *action)
+{
+  const auto data = action->data().toList();
+  if(data.size() != 3) return;
+
+  LogiLED::getInstance().setZoneBinding(static_cast<LogiLED::Zone>(data.at(0).toInt()),
+                                        static_cast<LogiLED::Binding>(data.at(1).toInt()),
+                                        data.at(2).toString());
+
+  saveSettings();
+}
+
+//-----------------------------------------------------------------
+bool MultiAlarm::retargetKeyboardZones(const LogiLED::Binding binding, const QString &previousName, const QString &name)
+{
+  auto &logiled = LogiLED::getInstance();
+  bool changed = false;
+
+  for(int i = 0; i < LogiLED::ZONE_COUNT; ++i)
+  {
+    const auto zone = static_cast<LogiLED::Zone>(i);
+    if(logiled.zoneBinding(zone) != binding || logiled.zoneTarget(zone) != previousName) continue;
+
+    if(name.isEmpty()) logiled.setZoneBinding(zone, LogiLED::Binding::NONE);
+    else               logiled.setZoneBinding(zone, binding, name);
+
+    changed = true;
+  }
+
+  return changed;
+}
+
 //-----------------------------------------------------------------
 void MultiAlarm::setupTrayIcon()
 {
@@ -227,38 +457,394 @@ void MultiAlarm::onQuitActionActivated()
 //-----------------------------------------------------------------
 void MultiAlarm::addAlarmWidget(AlarmWidget *widget)
 {
+  if(widget) addAlarmWidgets({widget});
+}
+
+//-----------------------------------------------------------------
+void MultiAlarm::addAlarmWidgets(const QList<AlarmWidget *> &widgets)
+{
+  if(widgets.isEmpty()) return;
+
+  // the alarms list is updated once at the end, not once per alarm.
+  m_scrollWidget->setUpdatesEnabled(false);
+
+  m_alarms.reserve(m_alarms.size() + widgets.size());
+
+  for(auto widget: widgets)
+  {
+    connect(widget, SIGNAL(deleteAlarm()),
+            this,   SLOT(onAlarmDeleted()));
+
+    connect(widget, SIGNAL(selectionRequested(bool)),
+            this,   SLOT(onAlarmSelectionRequested(bool)));
+
+    connect(widget, SIGNAL(configurationChanged(const QString &)),
+            this,   SLOT(onAlarmConfigurationChanged(const QString &)));
+
+    connect(widget, SIGNAL(stateChanged()),
+            this,   SLOT(onAlarmStateChanged()));
+
+    m_alarms << widget;
+    placeAlarmWidget(widget);
+  }
+
+  m_scrollWidget->setUpdatesEnabled(true);
+
+  updateLayout();
+  updateBulkActions();
+}
+
+//-----------------------------------------------------------------
+void MultiAlarm::placeAlarmWidget(AlarmWidget *widget)
+{
+  const auto groupName = widget->alarmConfiguration().group;
+
+  if(groupName.isEmpty())
+  {
+    m_scrollWidget->layout()->addWidget(widget);
+    widget->show();
+    return;
+  }
+
+  auto group = m_groups.value(groupName, nullptr);
+  if(!group)
+  {
+    group = new AlarmGroupWidget(groupName, m_scrollWidget);
+    m_groups.insert(groupName, group);
+    m_scrollWidget->layout()->addWidget(group);
+
+    connect(group, SIGNAL(collapsedChanged(bool)),
+            this,  SLOT(onGroupCollapsedChanged()));
+
+    connect(group, SIGNAL(startGroup()),
+            this,  SLOT(onGroupStart()));
+
+    connect(group, SIGNAL(pauseGroup()),
+            this,  SLOT(onGroupPause()));
+
+    connect(group, SIGNAL(stopGroup()),
+            this,  SLOT(onGroupStop()));
+
+    connect(group, SIGNAL(deleteGroup()),
+            this,  SLOT(onGroupDelete()));
+  }
+
+  // the members container of a collapsed group is hidden, the member itself is never hidden or it
+  // would stay hidden when the group is expanded.
+  group->addAlarm(widget);
+  widget->show();
+}
+
+//-----------------------------------------------------------------
+void MultiAlarm::detachAlarmWidget(AlarmWidget *widget)
+{
+  auto group = groupOf(widget);
+
+  if(!group)
+  {
+    m_scrollWidget->layout()->removeWidget(widget);
+    return;
+  }
+
+  group->removeAlarm(widget);
+
+  if(group->count() == 0)
+  {
+    widget->setParent(m_scrollWidget);
+    m_scrollWidget->layout()->removeWidget(group);
+    m_groups.remove(group->name());
+    group->deleteLater();
+  }
+}
+
+//-----------------------------------------------------------------
+AlarmGroupWidget *MultiAlarm::groupOf(AlarmWidget *widget) const
+{
+  const auto group = m_groups.value(widget->alarmConfiguration().group, nullptr);
+  if(group && group->contains(widget)) return group;
+
+  // the alarm could have been reconfigured with a different group.
+  for(auto other: m_groups)
+    if(other->contains(widget)) return other;
+
+  return nullptr;
+}
+
+//-----------------------------------------------------------------
+void MultiAlarm::onAlarmConfigurationChanged(const QString &previousName)
+{
+  auto widget = qobject_cast<AlarmWidget *>(sender());
   if(!widget) return;
 
-  m_scrollArea->show();
+  journal(AlarmJournal::Entry{AlarmJournal::Operation::MODIFY, previousName, widget->alarmConfiguration()});
 
-  auto oldHeight = currentHeight();
-  auto barEnabled = (oldHeight > MAX_HEIGHT);
+  // the keyboard zones bound by name follow the alarm.
+  bool zonesChanged = previousName != widget->name() && retargetKeyboardZones(LogiLED::Binding::ALARM, previousName, widget->name());
 
-  connect(widget, SIGNAL(deleteAlarm()),
-          this,   SLOT(onAlarmDeleted()));
+  auto group = groupOf(widget);
+  const auto groupName = widget->alarmConfiguration().group;
 
-  m_alarms << widget;
-  m_scrollWidget->layout()->addWidget(widget);
+  if((group && group->name() == groupName) || (!group && groupName.isEmpty()))
+  {
+    if(zonesChanged) saveSettings();
+    return;
+  }
 
-  auto height = currentHeight();
-  auto needBar = (height > MAX_HEIGHT);
+  const auto previousGroup = group ? group->name() : QString();
+  const auto groupExisted  = m_groups.contains(groupName);
 
-  if(barEnabled != needBar)
+  detachAlarmWidget(widget);
+  placeAlarmWidget(widget);
+
+  // the only alarm of the group moved to a new group renames it, to an existing group or none removes it.
+  if(!previousGroup.isEmpty() && !m_groups.contains(previousGroup))
+  {
+    const auto renamed = !groupName.isEmpty() && !groupExisted;
+    zonesChanged |= retargetKeyboardZones(LogiLED::Binding::GROUP, previousGroup, renamed ? groupName : QString());
+  }
+
+  if(zonesChanged) saveSettings();
+
+  updateLayout();
+}
+
+//-----------------------------------------------------------------
+void MultiAlarm::onAlarmStateChanged()
+{
+  auto widget = qobject_cast<AlarmWidget *>(sender());
+  if(!widget || m_restoring || !widget->alarmConfiguration().isTimer) return;
+
+  // the deadline is absolute, so this is only written on start, pause, resume, stop and loop restarts.
+  AlarmConfiguration conf;
+  conf.state = widget->alarmState();
+
+  journal(AlarmJournal::Entry{AlarmJournal::Operation::STATE, widget->name(), conf});
+}
+
+//-----------------------------------------------------------------
+void MultiAlarm::onGroupCollapsedChanged()
+{
+  updateLayout();
+
+  if(!m_restoring) saveSettings();
+}
+
+//-----------------------------------------------------------------
+void MultiAlarm::onGroupStart()
+{
+  auto group = qobject_cast<AlarmGroupWidget *>(sender());
+  if(group) applyBulkAction(BulkAction::START, group->alarms());
+}
+
+//-----------------------------------------------------------------
+void MultiAlarm::onGroupPause()
+{
+  auto group = qobject_cast<AlarmGroupWidget *>(sender());
+  if(group) applyBulkAction(BulkAction::PAUSE, group->alarms());
+}
+
+//-----------------------------------------------------------------
+void MultiAlarm::onGroupStop()
+{
+  auto group = qobject_cast<AlarmGroupWidget *>(sender());
+  if(group) applyBulkAction(BulkAction::STOP, group->alarms());
+}
+
+//-----------------------------------------------------------------
+void MultiAlarm::onGroupDelete()
+{
+  auto group = qobject_cast<AlarmGroupWidget *>(sender());
+  if(!group) return;
+
+  const auto button = QMessageBox::question(this, tr("Delete Group"), tr("Delete the %1 alarms of group '%2'?").arg(group->count()).arg(group->name()));
+  if(button == QMessageBox::Yes)
+    applyBulkAction(BulkAction::REMOVE, group->alarms());
+}
+
+//-----------------------------------------------------------------
+void MultiAlarm::removeAlarmWidgets(const QList<AlarmWidget *> &widgets)
+{
+  if(widgets.isEmpty()) return;
+
+  bool zonesChanged = false;
+
+  for(auto widget: widgets)
+  {
+    journal(AlarmJournal::Entry{AlarmJournal::Operation::REMOVE, widget->name(), AlarmConfiguration()});
+
+    const auto group = groupOf(widget);
+    const auto groupName = group ? group->name() : QString();
+
+    detachAlarmWidget(widget);
+    m_alarms.removeOne(widget);
+    widget->hide();
+    widget->deleteLater();
+
+    // the keyboard zones bound to the alarm or its removed group are turned off.
+    zonesChanged |= retargetKeyboardZones(LogiLED::Binding::ALARM, widget->name(), QString());
+    if(!groupName.isEmpty() && !m_groups.contains(groupName))
+      zonesChanged |= retargetKeyboardZones(LogiLED::Binding::GROUP, groupName, QString());
+  }
+
+  if(zonesChanged) saveSettings();
+
+  updateLayout();
+  updateBulkActions();
+}
+
+//-----------------------------------------------------------------
+void MultiAlarm::updateLayout()
+{
+  const auto height = currentHeight();
+  const auto needBar = (height > MAX_HEIGHT);
+
+  if(m_barVisible != needBar)
   {
     auto bar = m_scrollArea->verticalScrollBar();
-    bar->show();
+    bar->setVisible(needBar);
+
+    setFixedWidth(size().width() + (needBar ? BAR_WIDTH : -BAR_WIDTH));
+    m_barVisible = needBar;
+  }
+
+  setFixedHeight(needBar ? MAX_HEIGHT : height);
+
+  m_scrollArea->setVisible(!m_alarms.empty());
+}
+
+//-----------------------------------------------------------------
+void MultiAlarm::applyBulkAction(const BulkAction action, const QList<AlarmWidget *> &widgets)
+{
+  if(widgets.isEmpty()) return;
 
-    height = MAX_HEIGHT;
-    setFixedWidth(size().width() + BAR_WIDTH);
+  // Lights and the alarms list are updated once at the end, not once per alarm.
+  auto &logiled = LogiLED::getInstance();
+  logiled.beginBatch();
+  m_scrollWidget->setUpdatesEnabled(false);
+
+  switch(action)
+  {
+    case BulkAction::START:
+      for(auto widget: widgets) widget->startAlarm();
+      break;
+    case BulkAction::PAUSE:
+      for(auto widget: widgets) widget->pauseAlarm();
+      break;
+    case BulkAction::STOP:
+      for(auto widget: widgets) widget->stopAlarm();
+      break;
+    case BulkAction::REMOVE:
+      for(auto widget: widgets) widget->stopAlarm();
+      removeAlarmWidgets(widgets);
+      break;
+    default:
+      break;
   }
 
-  setFixedHeight(height);
+  m_scrollWidget->setUpdatesEnabled(true);
+  logiled.endBatch();
+}
+
+//-----------------------------------------------------------------
+void MultiAlarm::onBulkActionTriggered()
+{
+  auto action = qobject_cast<QAction *>(sender());
+  if(!action) return;
+
+  const bool selected = (action == m_startSelectedAction) || (action == m_pauseSelectedAction) ||
+                        (action == m_stopSelectedAction)  || (action == m_deleteSelectedAction);
+  const auto widgets = selected ? selectedAlarms() : m_alarms;
+
+  if(action == m_startAllAction || action == m_startSelectedAction)
+    applyBulkAction(BulkAction::START, widgets);
+  else if(action == m_pauseAllAction || action == m_pauseSelectedAction)
+    applyBulkAction(BulkAction::PAUSE, widgets);
+  else if(action == m_stopAllAction || action == m_stopSelectedAction)
+    applyBulkAction(BulkAction::STOP, widgets);
+  else if(action == m_deleteAllAction || action == m_deleteSelectedAction)
+  {
+    if(action == m_deleteAllAction)
+    {
+      const auto button = QMessageBox::question(this, tr("Delete All Alarms"), tr("Delete all %1 alarms?").arg(widgets.size()));
+      if(button != QMessageBox::Yes) return;
+    }
+    else if(widgets.size() > 1)
+    {
+      // a single alarm is deleted without confirmation, like with its delete button.
+      const auto button = QMessageBox::question(this, tr("Delete Selected Alarms"), tr("Delete the %1 selected alarms?").arg(widgets.size()));
+      if(button != QMessageBox::Yes) return;
+    }
+
+    applyBulkAction(BulkAction::REMOVE, widgets);
+  }
+}
+
+//-----------------------------------------------------------------
+void MultiAlarm::onAlarmSelectionRequested(bool extend)
+{
+  auto widget = qobject_cast<AlarmWidget *>(sender());
+  if(!widget) return;
+
+  if(extend)
+  {
+    widget->setSelected(!widget->isSelected());
+  }
+  else
+  {
+    const auto selected = !widget->isSelected() || selectedAlarms().size() > 1;
+    for(auto alarm: m_alarms)
+      alarm->setSelected(selected && alarm == widget);
+  }
+
+  updateBulkActions();
+}
+
+//-----------------------------------------------------------------
+void MultiAlarm::selectAll()
+{
+  for(auto alarm: m_alarms)
+    alarm->setSelected(true);
+
+  updateBulkActions();
+}
+
+//-----------------------------------------------------------------
+void MultiAlarm::clearSelection()
+{
+  for(auto alarm: m_alarms)
+    alarm->setSelected(false);
+
+  updateBulkActions();
+}
+
+//-----------------------------------------------------------------
+QList<AlarmWidget *> MultiAlarm::selectedAlarms() const
+{
+  QList<AlarmWidget *> result;
+
+  for(auto alarm: m_alarms)
+    if(alarm->isSelected()) result << alarm;
+
+  return result;
+}
+
+//-----------------------------------------------------------------
+void MultiAlarm::updateBulkActions()
+{
+  const auto hasAlarms = !m_alarms.isEmpty();
+  const auto hasSelection = !selectedAlarms().isEmpty();
+
+  for(auto action: {m_startAllAction, m_pauseAllAction, m_stopAllAction, m_deleteAllAction, m_selectAllAction})
+    action->setEnabled(hasAlarms);
+
+  for(auto action: {m_startSelectedAction, m_pauseSelectedAction, m_stopSelectedAction, m_deleteSelectedAction, m_clearSelectionAction})
+    action->setEnabled(hasSelection);
 }
 
 //-----------------------------------------------------------------
 void MultiAlarm::restoreSettings()
 {
-  const auto settings = applicationSettings();
+  const auto &settings = m_settings;
 
   if(settings->contains(STATE))
   {
@@ -272,21 +858,100 @@ void MultiAlarm::restoreSettings()
     restoreGeometry(geometry);
   }
 
+  // set before any alarm prepares its sound.
+  const auto cacheSize = settings->value(SOUND_CACHE_SIZE, 64).toLongLong();
+  SoundBank::getInstance().setCacheLimit(qMax<qint64>(1, cacheSize) * 1024 * 1024);
+
+  LogiLED::getInstance().setFrameRate(settings->value(LED_FRAME_RATE, 30).toInt());
+
+  // the zones never configured keep the default binding.
+  settings->beginGroup(LED_ZONES);
+  const auto zones = settings->childGroups();
+  for(int i = 0; i < LogiLED::ZONE_COUNT; ++i)
+  {
+    if(!zones.contains(QString::number(i))) continue;
+
+    settings->beginGroup(QString::number(i));
+    const auto binding = qBound(0, settings->value(LED_ZONE_BINDING, 0).toInt(), static_cast<int>(LogiLED::Binding::GROUP));
+    LogiLED::getInstance().setZoneBinding(static_cast<LogiLED::Zone>(i), static_cast<LogiLED::Binding>(binding), settings->value(LED_ZONE_TARGET, QString()).toString());
+    settings->endGroup();
+  }
+  settings->endGroup();
+
+  m_binaryStore = AlarmStore::usesBinaryStore(*settings);
+  m_binaryPath = dataPath(*settings, BINARY_FILENAME);
+  m_binaryStoreAction->setChecked(m_binaryStore);
+
+  const auto journalPath = dataPath(*settings, JOURNAL_FILENAME);
+
+  // stored alarms plus the changes not yet written to the store, in the order they were made.
+  const auto stored = m_binaryStore ? AlarmStore::loadBinary(m_binaryPath) : AlarmStore::readAlarms(*settings);
+
+  const auto journaled = AlarmJournal::read(journalPath);
+
+  m_writer = new AlarmWriter(journalPath, m_binaryPath, m_binaryStore, settings->fileName(), settings->format(), stored, journaled);
+  m_writer->moveToThread(&m_writerThread);
+
+  QMap<QString, AlarmConfiguration> alarms;
+  for(const auto &conf: stored)
+    alarms.insert(conf.name, conf);
+
+  AlarmJournal::apply(journaled, alarms);
+
   QStringList expired;
+  QList<AlarmWidget *> widgets;
+  QList<AlarmState> states;
 
-  settings->beginGroup(ALARMS);
-  auto alarmIds = settings->childGroups();
-  alarmIds.sort();
-  for(auto &alarmName : alarmIds)
+  widgets.reserve(alarms.size());
+  states.reserve(alarms.size());
+
+  m_restoring = true;
+  for(const auto &conf: alarms)
   {
-    auto alarmWidget = createAlarmWidget(*settings, alarmName);
+    auto alarmWidget = createAlarmWidget(conf);
 
     if(alarmWidget)
-      addAlarmWidget(alarmWidget);
+    {
+      widgets << alarmWidget;
+      states << conf.state;
+    }
     else
-      expired << alarmName;
+    {
+      expired << conf.name;
+      journal(AlarmJournal::Entry{AlarmJournal::Operation::REMOVE, conf.name, AlarmConfiguration()});
+    }
+  }
+
+  // the alarms list and the keyboard lights are updated once, not once per alarm.
+  auto &logiled = LogiLED::getInstance();
+  logiled.beginBatch();
+
+  addAlarmWidgets(widgets);
+
+  for(int i = 0; i < widgets.size(); ++i)
+    widgets.at(i)->restoreState(states.at(i));
+
+  logiled.endBatch();
+
+  m_writerThread.start(QThread::LowPriority);
+
+  // the registry can't be watched.
+  if(settings->format() == QSettings::IniFormat)
+    m_storeWatcher.addPath(settings->fileName());
+
+  if(m_binaryStore && QFile::exists(m_binaryPath))
+    m_storeWatcher.addPath(m_binaryPath);
+
+  settings->beginGroup(GROUPS);
+  for(auto group: m_groups)
+  {
+    settings->beginGroup(group->name());
+    group->setAggregate(static_cast<AlarmGroupWidget::Aggregate>(settings->value(GROUP_AGGREGATE, static_cast<int>(AlarmGroupWidget::Aggregate::MEAN)).toInt()));
+    group->setCollapsed(settings->value(GROUP_COLLAPSED, false).toBool());
+    settings->endGroup();
   }
   settings->endGroup();
+  m_restoring = false;
 
   if(!expired.empty())
   {
@@ -294,61 +959,47 @@ void MultiAlarm::restoreSettings()
     for(auto alarm: expired)
       message += alarm + QString("\n");
 
-    QMessageBox mb;
-    mb.setWindowTitle("Expired Clock Alarms");
-    mb.setWindowIcon(QIcon(":/MultiAlarm/application.ico"));
-    mb.setText(message);
-    mb.exec();
+    qWarning() << "Expired clock alarms deleted:" << expired.join(", ");
+
+    // shown when the event loop starts, the command line exits before that with --quit.
+    QMetaObject::invokeMethod(this, [message]()
+    {
+      QMessageBox mb;
+      mb.setWindowTitle("Expired Clock Alarms");
+      mb.setWindowIcon(QIcon(":/MultiAlarm/application.ico"));
+      mb.setText(message);
+      mb.exec();
+    }, Qt::QueuedConnection);
   }
 }
 
 //-----------------------------------------------------------------
 void MultiAlarm::saveSettings() const
 {
-  auto settings = applicationSettings();
-
-  settings->setValue(STATE, saveState());
-  settings->setValue(GEOMETRY, saveGeometry());
+  QVariantMap values;
+  values.insert(STATE, saveState());
+  values.insert(GEOMETRY, saveGeometry());
 
-  settings->beginGroup(ALARMS);
+  // removes the groups that no longer exist, written before the current ones because keys are sorted.
+  values.insert(GROUPS, QVariant());
 
-  for(auto alarm: settings->childGroups())
-    settings->remove(alarm);
+  for(auto group: m_groups)
+  {
+    const auto key = GROUPS + "/" + group->name() + "/";
+    values.insert(key + GROUP_AGGREGATE, static_cast<int>(group->aggregate()));
+    values.insert(key + GROUP_COLLAPSED, group->isCollapsed());
+  }
 
-  if(!m_alarms.empty())
+  const auto &logiled = LogiLED::getInstance();
+  for(int i = 0; i < LogiLED::ZONE_COUNT; ++i)
   {
-    for(auto widget: m_alarms)
-    {
-      auto conf = widget->alarmConfiguration();
-
-      settings->beginGroup(widget->name());
-
-      settings->setValue(ALARM_MESSAGE, conf.message);
-      settings->setValue(ALARM_COLOR, widget->color());
-      settings->setValue(ALARM_IS_TIMER, conf.isTimer);
-
-      if(conf.isTimer)
-      {
-        settings->setValue(ALARM_TIMER_LOOP, conf.timerLoops);
-        settings->setValue(ALARM_TIMER_TIME, conf.timerTime);
-      }
-      else
-        settings->setValue(ALARM_CLOCK_DATETIME, conf.clockDateTime);
-
-      settings->setValue(ALARM_SOUND, conf.sound);
-      settings->setValue(ALARM_SOUND_VOLUME, conf.soundVolume);
-      settings->setValue(ALARM_USE_TRAY, conf.useTray);
-      settings->setValue(ALARM_USE_DESKTOP, conf.useDesktopWidget);
-      settings->setValue(ALARM_USE_LOGILED, conf.useLogiled);
-      settings->setValue(ALARM_WIDGET_POSITION, conf.widgetPosition);
-      settings->setValue(ALARM_WIDGET_OPACITY, conf.widgetOpacity);
-
-      settings->endGroup();
-    }
+    const auto zone = static_cast<LogiLED::Zone>(i);
+    const auto key = LED_ZONES + "/" + QString::number(i) + "/";
+    values.insert(key + LED_ZONE_BINDING, static_cast<int>(logiled.zoneBinding(zone)));
+    values.insert(key + LED_ZONE_TARGET, logiled.zoneTarget(zone));
   }
 
-  settings->endGroup();
-  settings->sync();
+  m_writer->setValues(values);
 }
 
 //-----------------------------------------------------------------
@@ -357,108 +1008,375 @@ void MultiAlarm::onAlarmDeleted()
   AlarmWidget* widget = qobject_cast<AlarmWidget *>(sender());
   if(!widget) return;
 
-  auto oldHeight = currentHeight();
-  auto barEnabled = (oldHeight > MAX_HEIGHT);
+  removeAlarmWidgets({widget});
+}
+
+//-----------------------------------------------------------------
+AlarmWidget* MultiAlarm::createAlarmWidget(const AlarmConfiguration &conf)
+{
+  if(!conf.isTimer && conf.clockDateTime < QDateTime::currentDateTime())
+    return nullptr;
+
+  auto widget = new AlarmWidget(this);
+  widget->setConfiguration(conf);
+
+  return widget;
+}
+
+//-----------------------------------------------------------------
+void MultiAlarm::journal(const AlarmJournal::Entry &entry)
+{
+  if(!m_writer) return;
+
+  m_writer->append(entry);
+}
 
-  m_scrollWidget->layout()->removeWidget(widget);
-  m_alarms.removeOne(widget);
-  widget->deleteLater();
+//-----------------------------------------------------------------
+void MultiAlarm::journal(const QList<AlarmJournal::Entry> &entries)
+{
+  if(!m_writer || entries.isEmpty()) return;
 
-  auto newHeight = currentHeight();
-  auto needBar = (newHeight > MAX_HEIGHT);
+  m_writer->append(entries);
+}
 
-  if(barEnabled != needBar)
+//-----------------------------------------------------------------
+void MultiAlarm::onBinaryStoreToggled(bool value)
+{
+  if(value == m_binaryStore) return;
+
+  // enabled again when the writer has moved the alarms.
+  m_binaryStoreAction->setEnabled(false);
+
+  m_writer->setStore(value);
+}
+
+//-----------------------------------------------------------------
+void MultiAlarm::onStoreChanged(bool binary)
+{
+  m_binaryStore = binary;
+
+  const auto watched = m_storeWatcher.files().contains(m_binaryPath);
+  if(binary && !watched && QFile::exists(m_binaryPath)) m_storeWatcher.addPath(m_binaryPath);
+  else if(!binary && watched)                           m_storeWatcher.removePath(m_binaryPath);
+
+  m_binaryStoreAction->blockSignals(true);
+  m_binaryStoreAction->setChecked(binary);
+  m_binaryStoreAction->blockSignals(false);
+  m_binaryStoreAction->setEnabled(true);
+}
+
+//-----------------------------------------------------------------
+void MultiAlarm::onWriterError(const QString &message)
+{
+  QMessageBox::warning(this, tr("MultiAlarm"), message);
+}
+
+//-----------------------------------------------------------------
+void MultiAlarm::onStoreFileChanged(const QString &path)
+{
+  // a file replaced with a rename is no longer watched.
+  if(!m_storeWatcher.files().contains(path) && QFile::exists(path))
+    m_storeWatcher.addPath(path);
+
+  // several writes of an external program are checked at once. The writer thread reloads and
+  // compares the store, only the changes are sent back.
+  m_reloadTimer.start();
+}
+
+//-----------------------------------------------------------------
+void MultiAlarm::onStoreEdited(const QList<AlarmConfiguration> &changed, const QStringList &removed)
+{
+  QHash<QString, AlarmWidget *> widgets;
+  for(auto alarm: m_alarms)
+    widgets.insert(alarm->name(), alarm);
+
+  QList<AlarmWidget *> removedWidgets;
+  for(const auto &name: removed)
   {
-    auto bar = m_scrollArea->verticalScrollBar();
-    bar->hide();
+    auto widget = widgets.value(name, nullptr);
+    if(widget) removedWidgets << widget;
+  }
+
+  auto &logiled = LogiLED::getInstance();
+  logiled.beginBatch();
+
+  // only the modified alarms are touched, running alarms not in the changes keep running.
+  applyBulkAction(BulkAction::REMOVE, removedWidgets);
+
+  QList<AlarmWidget *> added;
+  QList<AlarmState> states;
 
-    setFixedWidth(size().width() - BAR_WIDTH);
+  for(const auto &conf: changed)
+  {
+    auto widget = widgets.value(conf.name, nullptr);
+
+    if(widget && !removedWidgets.contains(widget))
+    {
+      widget->reconfigure(conf);
+      widget->restoreState(conf.state);
+      continue;
+    }
+
+    widget = createAlarmWidget(conf);
+    if(widget)
+    {
+      added << widget;
+      states << conf.state;
+    }
   }
 
-  if(needBar)
-    setFixedHeight(MAX_HEIGHT);
-  else
-    setFixedHeight(newHeight);
+  insertAlarmWidgets(added);
+
+  for(int i = 0; i < added.size(); ++i)
+    added.at(i)->restoreState(states.at(i));
 
-  if(m_alarms.empty())
-    m_scrollArea->hide();
+  logiled.endBatch();
 }
 
 //-----------------------------------------------------------------
-AlarmWidget* MultiAlarm::createAlarmWidget(const NewAlarmDialog& dialog)
+void MultiAlarm::importIni()
 {
-  AlarmConfiguration conf;
-  conf.name    = dialog.name();
-  conf.message = dialog.message();
-  conf.color   = dialog.color().toLower();
-  conf.isTimer = dialog.isTimer();
+  const auto filename = QFileDialog::getOpenFileName(this, tr("Import Alarms"), QDir::homePath(), tr("INI files (*.ini)"));
+  if(filename.isEmpty()) return;
+
+  QSettings ini(filename, QSettings::IniFormat);
 
-  if(conf.isTimer)
+  QSet<QString> names;
+  for(const auto &name: usedNames())
+    names.insert(name.toCaseFolded());
+
+  const auto usedColorList = usedColors();
+  auto colors = QSet<QString>(usedColorList.constBegin(), usedColorList.constEnd());
+  QList<AlarmWidget *> widgets;
+  QStringList errors;
+
+  for(auto conf: AlarmStore::readAlarms(ini))
   {
-    conf.timerTime  = dialog.timerTime();
-    conf.timerLoops = dialog.timerLoop();
+    QString error;
+    AlarmWidget *widget = nullptr;
+
+    // the file can be edited by hand, the colors are validated as in the JSON files.
+    conf.color = conf.color.toLower();
+    if(!Utils::isColorName(conf.color))
+      error = tr("the color '%1' of '%2' is not valid").arg(conf.color).arg(conf.name);
+    else
+      widget = createImportedWidget(conf, names, colors, error);
+
+    if(widget) widgets << widget;
+    else       errors << error;
   }
-  else
-    conf.clockDateTime = dialog.clockDateTime();
 
-  conf.sound            = dialog.sound();
-  conf.soundVolume      = dialog.soundVolume();
-  conf.useTray          = dialog.showInTray();
-  conf.useDesktopWidget = dialog.showInDesktop();
-  conf.useLogiled       = dialog.showInKeyboard();
-  conf.widgetPosition   = dialog.desktopWidgetPosition();
-  conf.widgetOpacity    = dialog.widgetOpacity();
+  insertAlarmWidgets(widgets);
 
-  auto widget = new AlarmWidget(this);
-  widget->setConfiguration(conf);
+  showImportErrors(errors);
+}
 
-  return widget;
+//-----------------------------------------------------------------
+void MultiAlarm::importJson()
+{
+  const auto filename = QFileDialog::getOpenFileName(this, tr("Import Alarms"), QDir::homePath(), tr("JSON files (*.json)"));
+  if(filename.isEmpty()) return;
+
+  QStringList errors;
+  importJson(filename, errors);
+
+  showImportErrors(errors);
 }
 
 //-----------------------------------------------------------------
-AlarmWidget* MultiAlarm::createAlarmWidget(QSettings &settings, const QString &name)
+int MultiAlarm::importJson(const QString &filename, QStringList &errors)
 {
-  settings.beginGroup(name);
+  QFile file(filename);
+  if(!file.open(QIODevice::ReadOnly))
+  {
+    errors << tr("Unable to open '%1': %2").arg(QDir::toNativeSeparators(filename)).arg(file.errorString());
+    return 0;
+  }
 
-  AlarmConfiguration conf;
-  conf.name    = name;
-  conf.message = settings.value(ALARM_MESSAGE, QString()).toString();
-  conf.color   = settings.value(ALARM_COLOR, QString("white")).toString();
-  conf.isTimer = settings.value(ALARM_IS_TIMER, false).toBool();
+  QSet<QString> names;
+  for(const auto &name: usedNames())
+    names.insert(name.toCaseFolded());
+
+  const auto usedColorList = usedColors();
+  auto colors = QSet<QString>(usedColorList.constBegin(), usedColorList.constEnd());
+  QList<AlarmWidget *> widgets;
+
+  AlarmJson::Reader reader(&file);
+  QJsonObject object;
+  int record = 0;
 
-  if(conf.isTimer)
+  while(reader.next(object))
   {
-    conf.timerTime  = settings.value(ALARM_TIMER_TIME, QTime(0,1,0)).toTime();
-    conf.timerLoops = settings.value(ALARM_TIMER_LOOP, false).toBool();
+    ++record;
+
+    AlarmConfiguration conf;
+    QString error;
+    AlarmWidget *widget = nullptr;
+
+    if(AlarmJson::fromJson(object, conf, error))
+      widget = createImportedWidget(conf, names, colors, error);
+
+    if(widget) widgets << widget;
+    else       errors << tr("Alarm %1: %2").arg(record).arg(error);
   }
-  else
-    conf.clockDateTime = settings.value(ALARM_CLOCK_DATETIME, QDateTime()).toDateTime();
 
-  conf.sound            = settings.value(ALARM_SOUND, 0).toInt();
-  conf.soundVolume      = settings.value(ALARM_SOUND_VOLUME, 100).toInt();
-  conf.useTray          = settings.value(ALARM_USE_TRAY, false).toBool();
-  conf.useDesktopWidget = settings.value(ALARM_USE_DESKTOP, false).toBool();
-  conf.useLogiled       = settings.value(ALARM_USE_LOGILED, false).toBool();
-  conf.widgetPosition   = settings.value(ALARM_WIDGET_POSITION, QPoint{0,0}).toPoint();
-  conf.widgetOpacity    = settings.value(ALARM_WIDGET_OPACITY, 60).toInt();
+  if(!reader.error().isEmpty())
+    errors << reader.error();
 
-  settings.endGroup();
+  insertAlarmWidgets(widgets);
 
-  if(!conf.isTimer && conf.clockDateTime < QDateTime::currentDateTime())
+  return widgets.size();
+}
+
+//-----------------------------------------------------------------
+void MultiAlarm::exportJson()
+{
+  const auto filename = QFileDialog::getSaveFileName(this, tr("Export Alarms"), QDir::home().absoluteFilePath("MultiAlarm.json"), tr("JSON files (*.json)"));
+  if(filename.isEmpty()) return;
+
+  QString error;
+  if(!exportJson(filename, error))
+    QMessageBox::warning(this, tr("Export Alarms"), error);
+}
+
+//-----------------------------------------------------------------
+bool MultiAlarm::exportJson(const QString &filename, QString &error)
+{
+  QSaveFile file(filename);
+  if(file.open(QIODevice::WriteOnly))
+  {
+    AlarmJson::Writer writer(&file);
+
+    bool written = true;
+    for(auto alarm: m_alarms)
+    {
+      written = writer.write(alarm->alarmConfiguration());
+      if(!written) break;
+    }
+
+    if(written && writer.finish() && file.commit())
+      return true;
+  }
+
+  error = tr("Unable to write the file '%1': %2").arg(QDir::toNativeSeparators(filename)).arg(file.errorString());
+  return false;
+}
+
+//-----------------------------------------------------------------
+AlarmWidget *MultiAlarm::createImportedWidget(AlarmConfiguration conf, QSet<QString> &names, QSet<QString> &colors, QString &error)
+{
+  if(names.contains(conf.name.toCaseFolded()))
+  {
+    error = tr("the name '%1' is already in use").arg(conf.name);
     return nullptr;
+  }
 
-  auto widget = new AlarmWidget(this);
-  widget->setConfiguration(conf);
+  if(colors.contains(conf.color))
+  {
+    error = tr("the color '%1' of '%2' is already in use").arg(conf.color).arg(conf.name);
+    return nullptr;
+  }
+
+  // imported alarms are not started.
+  conf.state = AlarmState();
+
+  auto widget = createAlarmWidget(conf);
+  if(!widget)
+  {
+    error = tr("the clock alarm '%1' has expired").arg(conf.name);
+    return nullptr;
+  }
+
+  names.insert(conf.name.toCaseFolded());
+  colors.insert(conf.color);
 
   return widget;
 }
 
+//-----------------------------------------------------------------
+void MultiAlarm::insertAlarmWidgets(const QList<AlarmWidget *> &widgets)
+{
+  addAlarmWidgets(widgets);
+
+  QList<AlarmJournal::Entry> entries;
+  entries.reserve(widgets.size());
+
+  for(auto widget: widgets)
+  {
+    const auto conf = widget->alarmConfiguration();
+    entries << AlarmJournal::Entry{AlarmJournal::Operation::CREATE, conf.name, conf};
+  }
+
+  journal(entries);
+}
+
+//-----------------------------------------------------------------
+void MultiAlarm::showImportErrors(const QStringList &errors)
+{
+  if(errors.isEmpty()) return;
+
+  auto message = tr("The following alarms have not been imported:\n");
+  for(int i = 0; i < std::min(static_cast<int>(errors.size()), MAX_IMPORT_ERRORS); ++i)
+    message += errors.at(i) + QString("\n");
+
+  if(errors.size() > MAX_IMPORT_ERRORS)
+    message += tr("... and %1 more.").arg(errors.size() - MAX_IMPORT_ERRORS);
+
+  QMessageBox::information(this, tr("Import Alarms"), message);
+}
+
+//-----------------------------------------------------------------
+void MultiAlarm::exportIni()
+{
+  const auto filename = QFileDialog::getSaveFileName(this, tr("Export Alarms"), QDir::home().absoluteFilePath(INI_FILENAME), tr("INI files (*.ini)"));
+  if(filename.isEmpty()) return;
+
+  QSettings ini(filename, QSettings::IniFormat);
+  AlarmStore::clearAlarms(ini);
+  AlarmStore::writeAlarms(ini, alarmConfigurations());
+  ini.sync();
+
+  if(ini.status() != QSettings::NoError)
+    QMessageBox::warning(this, tr("Export Alarms"), tr("Unable to write the file '%1'.").arg(QDir::toNativeSeparators(filename)));
+}
+
+//-----------------------------------------------------------------
+QList<AlarmConfiguration> MultiAlarm::alarmConfigurations() const
+{
+  QList<AlarmConfiguration> result;
+
+  for(auto alarm: m_alarms)
+    result << alarm->alarmConfiguration();
+
+  return result;
+}
+
+//-----------------------------------------------------------------
+QString MultiAlarm::dataPath(const QSettings &settings, const QString &filename)
+{
+  QString directory;
+
+  if(settings.format() == QSettings::IniFormat)
+    directory = QFileInfo(settings.fileName()).absolutePath();
+  else
+    directory = QStandardPaths::writableLocation(QStandardPaths::AppLocalDataLocation);
+
+  QDir().mkpath(directory);
+
+  return QDir(directory).absoluteFilePath(filename);
+}
+
 //-----------------------------------------------------------------
 int MultiAlarm::currentHeight() const
 {
-  const auto alarmSize = m_alarms.size() * m_newButton->size().height();
+  auto rows = m_alarms.size();
+  for(auto group: m_groups)
+    if(group->isCollapsed()) rows -= group->count();
+
+  const auto alarmSize = rows * m_newButton->size().height();
+  const auto groupSize = m_groups.size() * AlarmGroupWidget::HEADER_HEIGHT;
 
-  return alarmSize + m_newButton->size().height() + menubar->height() + 4; // 4 is spacing in the bottom.
+  return alarmSize + groupSize + m_newButton->size().height() + menubar->height() + 4; // 4 is spacing in the bottom.
 }
 
 //-----------------------------------------------------------------
@@ -473,22 +1391,71 @@ void MultiAlarm::connectSignals()
   connect(m_newButton, SIGNAL(clicked(bool)),
           this,        SLOT(createNewAlarm()));
 
+  connect(m_newBatchAction, SIGNAL(triggered()),
+          this,             SLOT(createNewAlarms()));
+
   connect(m_aboutAction, SIGNAL(triggered()),
           this,          SLOT(aboutDialog()));
 
   connect(m_icon, SIGNAL(activated(QSystemTrayIcon::ActivationReason)),
           this,   SLOT(onTrayIconActivated(QSystemTrayIcon::ActivationReason)));
+
+  connect(m_writer, SIGNAL(storeChanged(bool)),
+          this,     SLOT(onStoreChanged(bool)));
+
+  connect(m_writer, SIGNAL(error(const QString &)),
+          this,     SLOT(onWriterError(const QString &)));
+
+  connect(&m_storeWatcher, SIGNAL(fileChanged(const QString &)),
+          this,            SLOT(onStoreFileChanged(const QString &)));
+
+  connect(&m_reloadTimer, SIGNAL(timeout()),
+          m_writer,       SLOT(checkStore()));
+
+  connect(m_writer, SIGNAL(storeEdited(const QList<AlarmConfiguration> &, const QStringList &)),
+          this,     SLOT(onStoreEdited(const QList<AlarmConfiguration> &, const QStringList &)));
+
+  connect(&m_writerThread, SIGNAL(finished()),
+          m_writer,        SLOT(deleteLater()));
+
+  for(auto action: {m_startAllAction, m_pauseAllAction, m_stopAllAction, m_deleteAllAction,
+                    m_startSelectedAction, m_pauseSelectedAction, m_stopSelectedAction, m_deleteSelectedAction})
+  {
+    connect(action, SIGNAL(triggered()),
+            this,   SLOT(onBulkActionTriggered()));
+  }
+
+  connect(m_selectAllAction, SIGNAL(triggered()),
+          this,              SLOT(selectAll()));
+
+  connect(m_clearSelectionAction, SIGNAL(triggered()),
+          this,                   SLOT(clearSelection()));
+
+  connect(m_importIniAction, SIGNAL(triggered()),
+          this,              SLOT(importIni()));
+
+  connect(m_exportIniAction, SIGNAL(triggered()),
+          this,              SLOT(exportIni()));
+
+  connect(m_importJsonAction, SIGNAL(triggered()),
+          this,               SLOT(importJson()));
+
+  connect(m_exportJsonAction, SIGNAL(triggered()),
+          this,               SLOT(exportJson()));
+
+  connect(m_binaryStoreAction, SIGNAL(toggled(bool)),
+          this,                SLOT(onBinaryStoreToggled(bool)));
 }
 
 //-----------------------------------------------------------------
-std::unique_ptr<QSettings> MultiAlarm::applicationSettings() const
+std::unique_ptr<QSettings> MultiAlarm::applicationSettings()
 {
   QDir applicationDir{QCoreApplication::applicationDirPath()};
   if(applicationDir.exists(INI_FILENAME))
   {
     const auto fInfo = QFileInfo(applicationDir.absoluteFilePath(INI_FILENAME));
     if(fInfo.isWritable())
-      return std::make_unique<QSettings>(INI_FILENAME, QSettings::IniFormat);
+      return std::make_unique<QSettings>(fInfo.absoluteFilePath(), QSettings::IniFormat);
   }
 
   return std::make_unique<QSettings>("Felix de las Pozas Alvarez", "MultiAlarm");
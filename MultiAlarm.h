@@ -22,13 +22,20 @@
 
 // Project
 #include <AlarmWidget.h>
+#include <AlarmGroupWidget.h>
 #include <NewAlarmDialog.h>
+#include <AlarmWriter.h>
+#include <LogiLED.h>
 #include <ui_MainWindow.h>
 
 // Qt
 #include <QMainWindow>
 #include <QSystemTrayIcon>
 #include <QSettings>
+#include <QTimer>
+#include <QThread>
+#include <QFileSystemWatcher>
+#include <QSet>
 
 // C++
 #include <memory>
@@ -57,6 +64,23 @@ class MultiAlarm
      */
     virtual ~MultiAlarm();
 
+    /** \brief Imports the alarms of a JSON file, reading one alarm at a time. Alarms with a name or
+     *         color already in use, invalid values or expired are skipped. Returns the number of
+     *         imported alarms.
+     * \param[in] filename JSON file path.
+     * \param[out] errors error messages of the skipped alarms.
+     *
+     */
+    int importJson(const QString &filename, QStringList &errors);
+
+    /** \brief Exports the alarms to a JSON file, writing one alarm at a time. Returns true on success
+     *         and false otherwise.
+     * \param[in] filename JSON file path.
+     * \param[out] error error message.
+     *
+     */
+    bool exportJson(const QString &filename, QString &error);
+
     /** \brief Return the list of used alarm names.
      *
      */
@@ -67,12 +91,29 @@ class MultiAlarm
      */
     QStringList usedColors() const;
 
+    /** \brief Returns the list of alarm group names.
+     *
+     */
+    QStringList groupNames() const;
+
+    /** \brief Returns the alarm creation and modification dialog, shared by all the alarms.
+     *
+     */
+    NewAlarmDialog *alarmDialog() const
+    { return m_dialog; }
+
   private slots:
     /** \brief Launches the alarm creation dialog.
      *
      */
     void createNewAlarm();
 
+    /** \brief Asks for the number of alarms and launches the alarm creation dialog to define the
+     *         template of all of them.
+     *
+     */
+    void createNewAlarms();
+
     /** \brief Launches the about dialog.
      *
      */
@@ -99,29 +140,174 @@ class MultiAlarm
      */
     void onAlarmDeleted();
 
+    /** \brief Updates the selection when an alarm widget is clicked.
+     * \param[in] extend true to toggle the alarm in the current selection and false to select only that alarm.
+     *
+     */
+    void onAlarmSelectionRequested(bool extend);
+
+    /** \brief Handles the bulk action menu entries.
+     *
+     */
+    void onBulkActionTriggered();
+
+    /** \brief Journals the modification of the alarm and moves it to its new group if it changed.
+     * \param[in] previousName name of the alarm before the modification.
+     *
+     */
+    void onAlarmConfigurationChanged(const QString &previousName);
+
+    /** \brief Journals the run state of the sender timer alarm so it can be resumed after a restart.
+     *
+     */
+    void onAlarmStateChanged();
+
+    /** \brief Updates the binary store menu entry when the writer has changed the store.
+     * \param[in] binary true if the alarms are in the binary store and false if they are in the settings.
+     *
+     */
+    void onStoreChanged(bool binary);
+
+    /** \brief Shows the writer error message.
+     * \param[in] message error message.
+     *
+     */
+    void onWriterError(const QString &message);
+
+    /** \brief Schedules the check of the alarms store in the writer thread when a store file is modified.
+     * \param[in] path settings or binary store file path.
+     *
+     */
+    void onStoreFileChanged(const QString &path);
+
+    /** \brief Applies the external modifications of the alarms store. Only the added, removed or modified
+     *         alarms are created, deleted or reconfigured.
+     * \param[in] changed added or modified alarms.
+     * \param[in] removed names of the removed alarms.
+     *
+     */
+    void onStoreEdited(const QList<AlarmConfiguration> &changed, const QStringList &removed);
+
+    /** \brief Updates the main window size when a group is collapsed or expanded.
+     *
+     */
+    void onGroupCollapsedChanged();
+
+    /** \brief Starts the alarms of the sender group.
+     *
+     */
+    void onGroupStart();
+
+    /** \brief Pauses the alarms of the sender group.
+     *
+     */
+    void onGroupPause();
+
+    /** \brief Stops the alarms of the sender group.
+     *
+     */
+    void onGroupStop();
+
+    /** \brief Deletes the alarms of the sender group.
+     *
+     */
+    void onGroupDelete();
+
+    /** \brief Imports the alarms of an INI file with the settings format. Alarms with a name
+     *         or color already in use are skipped.
+     *
+     */
+    void importIni();
+
+    /** \brief Exports the alarms to an INI file with the settings format.
+     *
+     */
+    void exportIni();
+
+    /** \brief Imports the alarms of a JSON file selected by the user.
+     *
+     */
+    void importJson();
+
+    /** \brief Exports the alarms to a JSON file selected by the user.
+     *
+     */
+    void exportJson();
+
+    /** \brief Moves the alarms between the settings and the binary store.
+     * \param[in] value true to use the binary store and false to use the settings.
+     *
+     */
+    void onBinaryStoreToggled(bool value);
+
+    /** \brief Selects all the alarms.
+     *
+     */
+    void selectAll();
+
+    /** \brief Clears the alarms selection.
+     *
+     */
+    void clearSelection();
+
+    /** \brief Fills the menu of a keyboard zone with the alarms and groups that can be shown in it.
+     *
+     */
+    void onKeyboardZoneMenuAboutToShow();
+
+    /** \brief Binds the keyboard zone of the action to its alarm, group or rotation.
+     * \param[in] action menu action with the zone and binding as data.
+     *
+     */
+    void onKeyboardZoneSelected(QAction *action);
+
   private:
+    /** \brief Operations that can be applied to several alarms at once.
+     *
+     */
+    enum class BulkAction: char { START = 0, PAUSE, STOP, REMOVE };
+
     virtual void changeEvent(QEvent *e);
     virtual void closeEvent(QCloseEvent *e);
 
-    /** \brief Creates a widget using the data from the dialog.
-     * \param[in] settings settings object containinf the alarm properties.
-     * \param[in] name alarm identificator.
+    /** \brief Creates a widget using the stored alarm configuration. Returns nullptr if the alarm
+     *         is an expired clock alarm.
+     * \param[in] conf alarm configuration.
      *
      */
-    AlarmWidget *createAlarmWidget(QSettings &settings, const QString &name);
+    AlarmWidget *createAlarmWidget(const AlarmConfiguration &conf);
 
-    /** \brief Creates a widget using the data from the dialog.
-     * \param[in] dialog finished dialog with the alarm properties.
+    /** \brief Restores application settings from ini file.
      *
      */
-    AlarmWidget *createAlarmWidget(const NewAlarmDialog &dialog);
+    void restoreSettings();
 
-    /** \brief Restores application settings from ini file.
+    /** \brief Appends the change to the alarms journal.
+     * \param[in] entry journal entry.
      *
      */
-    void restoreSettings();
+    void journal(const AlarmJournal::Entry &entry);
+
+    /** \brief Appends the changes to the alarms journal in a single write.
+     * \param[in] entries journal entries.
+     *
+     */
+    void journal(const QList<AlarmJournal::Entry> &entries);
 
-    /** \brief Saves application settings to ini file.
+    /** \brief Returns the path of the given data file, next to the settings INI file or
+     *         in the application data directory if the settings are stored in the registry.
+     * \param[in] settings application settings.
+     * \param[in] filename data file name.
+     *
+     */
+    static QString dataPath(const QSettings &settings, const QString &filename);
+
+    /** \brief Returns the configurations of the current alarms.
+     *
+     */
+    QList<AlarmConfiguration> alarmConfigurations() const;
+
+    /** \brief Sends the application settings to the writer.
      *
      */
     void saveSettings() const;
@@ -131,6 +317,11 @@ class MultiAlarm
      */
     void setupTrayIcon();
 
+    /** \brief Helper method to setup the keyboard zones menu.
+     *
+     */
+    void setupKeyboardMenu();
+
     /** \brief Makes all the connections between QObjects.
      *
      */
@@ -142,24 +333,131 @@ class MultiAlarm
      */
     void addAlarmWidget(AlarmWidget *widget);
 
+    /** \brief Adds the alarms to the list of alarms and configures the signals and UI, updating the
+     *         main window layout only once.
+     * \param[in] widgets widgets to add.
+     *
+     */
+    void addAlarmWidgets(const QList<AlarmWidget *> &widgets);
+
+    /** \brief Adds the imported or batch created alarms and journals their creation.
+     * \param[in] widgets widgets to add.
+     *
+     */
+    void insertAlarmWidgets(const QList<AlarmWidget *> &widgets);
+
+    /** \brief Creates the widgets of the alarms expanded from the template. The names are the template
+     *         name followed by a number, the first color is the template one and the rest are unused
+     *         colors. Returns fewer widgets if the colors run out.
+     * \param[in] conf template alarm configuration.
+     * \param[in] count number of alarms.
+     *
+     */
+    QList<AlarmWidget *> createAlarmWidgets(const AlarmConfiguration &conf, int count);
+
+    /** \brief Creates the widget of an imported alarm. Returns nullptr if the name, compared without case, or
+     *         the color is in use or the alarm has expired.
+     * \param[in] conf alarm configuration.
+     * \param[inout] names used names case folded, the alarm name is added.
+     * \param[inout] colors used colors, the alarm color is added.
+     * \param[out] error error message if the alarm can't be imported.
+     *
+     */
+    AlarmWidget *createImportedWidget(AlarmConfiguration conf, QSet<QString> &names, QSet<QString> &colors, QString &error);
+
+    /** \brief Shows the errors of an import, if any.
+     * \param[in] errors error messages.
+     *
+     */
+    void showImportErrors(const QStringList &errors);
+
+    /** \brief Inserts the widget in the section of its group, creating the group if needed, or in the
+     *         list of ungrouped alarms.
+     * \param[in] widget alarm widget.
+     *
+     */
+    void placeAlarmWidget(AlarmWidget *widget);
+
+    /** \brief Removes the widget from its group section, deleting the group if it becomes empty.
+     * \param[in] widget alarm widget.
+     *
+     */
+    void detachAlarmWidget(AlarmWidget *widget);
+
+    /** \brief Returns the group section containing the alarm or nullptr if the alarm is not grouped.
+     * \param[in] widget alarm widget.
+     *
+     */
+    AlarmGroupWidget *groupOf(AlarmWidget *widget) const;
+
+    /** \brief Removes the given alarms from the list of alarms and deletes the widgets.
+     * \param[in] widgets widgets to remove.
+     *
+     */
+    void removeAlarmWidgets(const QList<AlarmWidget *> &widgets);
+
+    /** \brief Binds the keyboard zones bound to the alarm or group to its new name, or turns them off if it
+     *         no longer exists. Returns true if any zone has changed.
+     * \param[in] binding ALARM or GROUP.
+     * \param[in] previousName previous name of the alarm or group.
+     * \param[in] name new name of the alarm or group, empty if removed.
+     *
+     */
+    bool retargetKeyboardZones(const LogiLED::Binding binding, const QString &previousName, const QString &name);
+
+    /** \brief Applies the given action to the alarms in a single pass, updating the keyboard lights and
+     *         the main window layout only once.
+     * \param[in] action action to apply.
+     * \param[in] widgets alarms to apply the action to.
+     *
+     */
+    void applyBulkAction(const BulkAction action, const QList<AlarmWidget *> &widgets);
+
+    /** \brief Returns the list of selected alarms.
+     *
+     */
+    QList<AlarmWidget *> selectedAlarms() const;
+
+    /** \brief Enables or disables the bulk action menu entries depending on the alarms and selection.
+     *
+     */
+    void updateBulkActions();
+
+    /** \brief Updates the main window height and scroll bar to the current number of alarms.
+     *
+     */
+    void updateLayout();
+
     /** \brief Returns the current height of the main window.
      *
      */
     int currentHeight() const;
 
     /** \brief Returns the application settings. From INI file if exists or the registry if not.
-     *         Needs to be a pointer because QSettings is not copyable.
+     *         Needs to be a pointer because QSettings is not copyable. Only called once on startup.
      *
      */
-    std::unique_ptr<QSettings> applicationSettings() const;
+    static std::unique_ptr<QSettings> applicationSettings();
 
   private:
-    QSystemTrayIcon *m_icon;              /** application icon when minimized.       */
-    QAction         *m_restoreMenuAction; /** restore application tray icon action.  */
-    QAction         *m_quitMenuAction;    /** quit application tray icon action.     */
-    bool             m_needsExit;         /** true to exit the application on close. */
+    QSystemTrayIcon                  *m_icon;              /** application icon when minimized.       */
+    NewAlarmDialog                   *m_dialog;            /** alarm creation dialog, reused.         */
+    QAction                          *m_restoreMenuAction; /** restore application tray icon action.  */
+    QAction                          *m_quitMenuAction;    /** quit application tray icon action.     */
+    bool                              m_needsExit;         /** true to exit the application on close. */
+    bool                              m_barVisible;        /** true if the scroll bar is visible.     */
+    bool                              m_restoring;         /** true while restoring the settings.     */
+    bool                              m_binaryStore;       /** true to store alarms in binary file.   */
+    QString                           m_binaryPath;        /** binary alarm store file path.          */
+
+    QList<AlarmWidget *>              m_alarms;            /** alarms widgets.                        */
+    QMap<QString, AlarmGroupWidget *> m_groups;            /** alarm group sections.                  */
 
-    QList<AlarmWidget *> m_alarms;        /** alarms widgets.                        */
+    std::unique_ptr<QSettings>        m_settings;          /** application settings.                  */
+    QFileSystemWatcher                m_storeWatcher;      /** watches the store files changes.       */
+    QTimer                            m_reloadTimer;       /** delays the check of the store changes. */
+    QThread                           m_writerThread;      /** alarms and settings writer thread.     */
+    AlarmWriter                      *m_writer;            /** alarms and settings writer.            */
 };
 
 #endif // MULTIALARM_H_
@@ -21,52 +21,27 @@
 #include <DesktopWidget.h>
 #include <NewAlarmDialog.h>
 #include <LogiLED.h>
+#include <ScreenGeometry.h>
+#include <SoundBank.h>
+#include <SoundMixer.h>
+#include <Utils.h>
 
 // Qt
-#include <QImage>
-#include <QPainter>
 #include <QIcon>
-#include <QPixmap>
 #include <QPushButton>
-#include <QTemporaryFile>
-#include <QScreen>
-#include <QSoundEffect>
 #include <QSystemTrayIcon>
-
-const QStringList soundFiles = { ":/MultiAlarm/sounds/Beeper 1.wav",
-                                 ":/MultiAlarm/sounds/Beeper 2.wav",
-                                 ":/MultiAlarm/sounds/Beeper 3.wav",
-                                 ":/MultiAlarm/sounds/Buzzer 1.wav",
-                                 ":/MultiAlarm/sounds/Buzzer 2.wav",
-                                 ":/MultiAlarm/sounds/Code Red.wav",
-                                 ":/MultiAlarm/sounds/Electronic.wav",
-                                 ":/MultiAlarm/sounds/Pager.wav",
-                                 ":/MultiAlarm/sounds/Smoke.wav" };
-
-const QStringList soundNames = { "Beeper 1",
-                                 "Beeper 2",
-                                 "Beeper 3",
-                                 "Buzzer 1",
-                                 "Buzzer 2",
-                                 "Code Red",
-                                 "Electronic",
-                                 "Pager",
-                                 "Smoke Alarm" };
-
-const QStringList defaultPositions = { "Top Left",
-                                       "Top Center",
-                                       "Top Right",
-                                       "Center Left",
-                                       "Center",
-                                       "Center Right",
-                                       "Bottom Left",
-                                       "Bottom Center",
-                                       "Bottom Right" };
-
-//-----------------------------------------------------------------
-NewAlarmDialog::NewAlarmDialog(QStringList invalidNames, QStringList invalidColors, QWidget * parent, Qt::WindowFlags flags)
-: QDialog       {parent}
-, m_invalidNames{invalidNames}
+#include <QSet>
+#include <QFileDialog>
+#include <QFileInfo>
+#include <QDir>
+#include <QStandardItemModel>
+#include <QShowEvent>
+
+//-----------------------------------------------------------------
+NewAlarmDialog::NewAlarmDialog(QWidget * parent, Qt::WindowFlags flags)
+: QDialog       {parent, flags}
+, m_preview     {-1}
+, m_soundIndex  {0}
 , m_widget      {true, this}
 {
   setWindowFlags(windowFlags() & ~Qt::WindowMinMaxButtonsHint & ~Qt::WindowContextHelpButtonHint);
@@ -92,36 +67,20 @@ NewAlarmDialog::NewAlarmDialog(QStringList invalidNames, QStringList invalidColo
 
   m_showTray->setVisible(QSystemTrayIcon::isSystemTrayAvailable());
 
+  // built once, the colors used by other alarms are disabled by setConfiguration().
   m_colors = QColor::colorNames();
-  for(auto color: invalidColors)
-  {
-    m_colors.removeAll(color);
-  }
-
-  auto toCamelCase = [](const QString &s)
-  {
-    QStringList words = s.split(" ", Qt::SkipEmptyParts);
-    for (QString &word : words)
-      word.front() = word.front().toUpper();
-
-    return words.join(" ");
-  };
-
-  for (auto color : m_colors)
+  for(const auto &color: m_colors)
   {
-    auto pixmap = new QImage(32, 32, QImage::Format_RGB32);
-    QPainter painter(pixmap);
-    painter.fillRect(0,0,31,31, color);
-    painter.end();
-    m_colorComboBox->insertItem(m_colors.indexOf(color), QIcon(QPixmap::fromImage(*pixmap)), toCamelCase(color));
+    m_colorComboBox->addItem(Utils::colorSwatch(color), Utils::colorDisplayName(color));
   }
   m_colorComboBox->setCurrentIndex(0);
   m_widget.setColor(m_colors.at(0));
 
-  m_soundComboBox->insertItems(0, soundNames);
+  m_soundComboBox->insertItems(0, SoundBank::names());
+  m_soundComboBox->addItem(tr("Sound file..."));
   m_soundComboBox->setCurrentIndex(0);
 
-  computeDesktopWidgetPositions();
+  onScreensChanged();
 
   connectSignals();
 
@@ -139,27 +98,121 @@ NewAlarmDialog::NewAlarmDialog(QStringList invalidNames, QStringList invalidColo
   m_clock->setMinimumTime(QTime{0,1,0});
 
   m_buttons->button(QDialogButtonBox::Ok)->setEnabled(false);
+
+  ensurePolished();
 }
 
 //-----------------------------------------------------------------
 NewAlarmDialog::~NewAlarmDialog()
 {
-  for(auto sound: m_sounds)
+  SoundMixer::getInstance().stop(m_preview);
+
+  if(m_showLogiled->isChecked())
   {
-    delete sound;
+    LogiLED::getInstance().unregisterItem("NewAlarm");
   }
-  m_sounds.clear();
+}
 
-  for(auto file: m_temporaryFiles)
+//-----------------------------------------------------------------
+void NewAlarmDialog::setConfiguration(const AlarmConfiguration &conf, const QStringList &invalidNames,
+                                      const QStringList &invalidColors, const QStringList &groups)
+{
+  m_invalidNames = invalidNames;
+
+  // the items are kept, only their state changes.
+  auto model = qobject_cast<QStandardItemModel *>(m_colorComboBox->model());
+  const QSet<QString> usedColors(invalidColors.cbegin(), invalidColors.cend());
+  for(int i = 0; i < m_colors.size(); ++i)
+  {
+    model->item(i)->setEnabled(!usedColors.contains(m_colors.at(i)));
+  }
+
+  setGroups(groups);
+  setName(conf.name);
+  setMessage(conf.message);
+  setColor(conf.color);
+  setGroup(conf.group);
+  setIsTimer(conf.isTimer);
+  setTimerTime(conf.timerTime.isValid() ? conf.timerTime : m_timer->minimumTime());
+  setTimerLoop(conf.timerLoops);
+  setClockDateTime(conf.clockDateTime.isValid() ? conf.clockDateTime : QDateTime::currentDateTime());
+  setSound(conf.sound);
+  setSoundFile(conf.soundFile);
+  setSoundVolume(conf.soundVolume);
+  setShowInTray(conf.useTray);
+  setShowInDesktop(conf.useDesktopWidget);
+  setShowInKeyboard(conf.useLogiled);
+  setDesktopWidgetPosition(conf.widgetPosition);
+  setWidgetOpacity(conf.widgetOpacity);
+
+  // the signals are only emitted on changes, the state of the previous alarm may be the same.
+  onTimerRadioToggled(m_timerRadio->isChecked());
+  onClockRadioToggled(m_clockRadio->isChecked());
+  onDesktopWidgetStateChanged(m_showDesktop->checkState());
+  setPlayButtonIcon();
+}
+
+//-----------------------------------------------------------------
+const AlarmConfiguration NewAlarmDialog::configuration() const
+{
+  AlarmConfiguration conf;
+  conf.name    = name();
+  conf.message = message();
+  conf.color   = color().toLower();
+  conf.group   = group();
+  conf.isTimer = isTimer();
+
+  if(conf.isTimer)
+  {
+    conf.timerTime  = timerTime();
+    conf.timerLoops = timerLoop();
+  }
+  else
   {
-    delete file;
+    conf.clockDateTime = clockDateTime();
   }
-  m_temporaryFiles.clear();
+
+  conf.sound            = sound();
+  conf.soundFile        = soundFile();
+  conf.soundVolume      = soundVolume();
+  conf.useTray          = showInTray();
+  conf.useDesktopWidget = showInDesktop();
+  conf.useLogiled       = showInKeyboard();
+  conf.widgetPosition   = desktopWidgetPosition();
+  conf.widgetOpacity    = widgetOpacity();
+
+  return conf;
+}
+
+//-----------------------------------------------------------------
+void NewAlarmDialog::showEvent(QShowEvent *e)
+{
+  QDialog::showEvent(e);
+
+  // the preview widget window is created once and only hidden between uses.
+  m_widget.setVisible(m_showDesktop->isChecked());
+
+  if(m_showLogiled->isChecked())
+  {
+    onKeyboardNotificationStateChanged(Qt::Checked);
+  }
+}
+
+//-----------------------------------------------------------------
+void NewAlarmDialog::done(int result)
+{
+  SoundMixer::getInstance().stop(m_preview);
+  m_preview = -1;
+  setPlayButtonIcon();
+
+  m_widget.hide();
 
   if(m_showLogiled->isChecked())
   {
     LogiLED::getInstance().unregisterItem("NewAlarm");
   }
+
+  QDialog::done(result);
 }
 
 //-----------------------------------------------------------------
@@ -190,7 +243,7 @@ void NewAlarmDialog::onDesktopWidgetStateChanged(int value)
   m_opacitySlider->setEnabled(enabled);
   m_opacitySliderValue->setEnabled(enabled);
 
-  value ? m_widget.show() : m_widget.hide();
+  m_widget.setVisible(enabled && isVisible());
 }
 
 //-----------------------------------------------------------------
@@ -210,7 +263,7 @@ void NewAlarmDialog::onWidgetPositionChanged(int value)
 {
   if(value != 0)
   {
-    m_widget.setPosition(m_widgetPositions.at(value));
+    m_widget.setPosition(ScreenGeometry::getInstance().positions().value(value));
   }
 }
 
@@ -245,17 +298,21 @@ void NewAlarmDialog::checkOkButtonRequirements()
 //-----------------------------------------------------------------
 void NewAlarmDialog::playSound()
 {
-  for(int i = 0; i < soundFiles.size(); ++i)
+  auto &mixer = SoundMixer::getInstance();
+
+  if(mixer.isPlaying(m_preview))
+  {
+    mixer.stop(m_preview);
+  }
+  else
   {
-    if(m_sounds[i]->isPlaying())
-    {
-      m_sounds[i]->stop();
-      return;
-    }
+    const auto file = soundFile();
+    const auto source = file.isEmpty() ? SoundBank::source(m_soundComboBox->currentIndex()) : file;
+
+    m_preview = mixer.play(source, m_volumeSlider->value(), false);
   }
 
-  m_sounds[m_soundComboBox->currentIndex()]->setVolume(m_volumeSlider->value()/100.0);
-  m_sounds[m_soundComboBox->currentIndex()]->play();
+  setPlayButtonIcon();
 }
 
 //-----------------------------------------------------------------
@@ -294,18 +351,23 @@ void NewAlarmDialog::connectSignals()
   connect(m_volumeSlider, SIGNAL(valueChanged(int)),
           this,           SLOT(onVolumeChanged(int)));
 
+  connect(m_soundComboBox, SIGNAL(activated(int)),
+          this,            SLOT(onSoundActivated(int)));
+
   connect(&m_widget, SIGNAL(beingDragged()),
           this,      SLOT(onWidgetBeingDragged()));
 
   connect(m_showLogiled, SIGNAL(stateChanged(int)),
           this,          SLOT(onKeyboardNotificationStateChanged(int)));
+
+  connect(&ScreenGeometry::getInstance(), SIGNAL(changed()),
+          this,                           SLOT(onScreensChanged()));
 }
 
 //-----------------------------------------------------------------
 void NewAlarmDialog::setPlayButtonIcon()
 {
-  auto sound = qobject_cast<QSoundEffect *>(sender());
-  if(sound->isPlaying())
+  if(SoundMixer::getInstance().isPlaying(m_preview))
   {
     m_playSoundButton->setIcon(QIcon(":/MultiAlarm/stop.svg"));
   }
@@ -345,6 +407,29 @@ const QString NewAlarmDialog::message() const
   return m_message->text();
 }
 
+//-----------------------------------------------------------------
+void NewAlarmDialog::setGroups(const QStringList &groups)
+{
+  const auto current = m_group->currentText();
+
+  m_group->clear();
+  m_group->addItem(QString());
+  m_group->addItems(groups);
+  m_group->setCurrentText(current);
+}
+
+//-----------------------------------------------------------------
+void NewAlarmDialog::setGroup(const QString &group)
+{
+  m_group->setCurrentText(group);
+}
+
+//-----------------------------------------------------------------
+const QString NewAlarmDialog::group() const
+{
+  return m_group->currentText().trimmed();
+}
+
 //-----------------------------------------------------------------
 bool NewAlarmDialog::isTimer() const
 {
@@ -354,7 +439,11 @@ bool NewAlarmDialog::isTimer() const
 //-----------------------------------------------------------------
 void NewAlarmDialog::setIsTimer(bool value)
 {
-  m_timerRadio->setChecked(value);
+  // the checked button of an exclusive pair can't be unchecked, the other one is checked instead.
+  if(value)
+    m_timerRadio->setChecked(true);
+  else
+    m_clockRadio->setChecked(true);
 }
 
 //-----------------------------------------------------------------
@@ -396,10 +485,11 @@ const QDateTime NewAlarmDialog::clockDateTime() const
 //-----------------------------------------------------------------
 void NewAlarmDialog::setColor(const QString& colorname)
 {
-  int index = 0;
-  if(m_colors.contains(colorname, Qt::CaseInsensitive))
+  auto index = m_colors.indexOf(colorname.toLower());
+  if(index == -1 || !isColorAvailable(index))
   {
-    index = m_colors.indexOf(colorname);
+    index = 0;
+    while(index < m_colors.size() - 1 && !isColorAvailable(index)) ++index;
   }
 
   m_colorComboBox->setCurrentIndex(index);
@@ -414,15 +504,62 @@ const QString NewAlarmDialog::color() const
 //-----------------------------------------------------------------
 void NewAlarmDialog::setSound(int soundIndex)
 {
-  soundIndex = soundIndex % m_soundComboBox->count();
+  m_soundIndex = soundIndex % SoundBank::count();
 
-  m_soundComboBox->setCurrentIndex(soundIndex);
+  m_soundComboBox->setCurrentIndex(m_soundIndex);
 }
 
 //-----------------------------------------------------------------
 int NewAlarmDialog::sound() const
 {
-  return m_soundComboBox->currentIndex();
+  return m_soundIndex;
+}
+
+//-----------------------------------------------------------------
+void NewAlarmDialog::setSoundFile(const QString &file)
+{
+  const auto index = SoundBank::count();
+
+  m_soundFile = file;
+
+  if(file.isEmpty())
+  {
+    m_soundComboBox->setItemText(index, tr("Sound file..."));
+    m_soundComboBox->setItemData(index, QVariant(), Qt::ToolTipRole);
+    return;
+  }
+
+  m_soundComboBox->setItemText(index, QFileInfo(file).fileName());
+  m_soundComboBox->setItemData(index, QDir::toNativeSeparators(file), Qt::ToolTipRole);
+  m_soundComboBox->setCurrentIndex(index);
+
+  // decoded in the background while the dialog is open, a long file doesn't delay the preview.
+  SoundBank::getInstance().prepare(file);
+}
+
+//-----------------------------------------------------------------
+const QString NewAlarmDialog::soundFile() const
+{
+  return m_soundComboBox->currentIndex() == SoundBank::count() ? m_soundFile : QString();
+}
+
+//-----------------------------------------------------------------
+void NewAlarmDialog::onSoundActivated(int index)
+{
+  if(index < SoundBank::count())
+  {
+    m_soundIndex = index;
+    return;
+  }
+
+  const auto directory = m_soundFile.isEmpty() ? QDir::homePath() : QFileInfo(m_soundFile).absolutePath();
+  const auto file = QFileDialog::getOpenFileName(this, tr("Select Sound File"), directory,
+                                                 tr("Audio files (*.wav *.mp3 *.ogg *.flac *.m4a *.wma);;All files (*)"));
+
+  if(!file.isEmpty())
+    setSoundFile(file);
+  else if(m_soundFile.isEmpty())
+    m_soundComboBox->setCurrentIndex(m_soundIndex);
 }
 
 //-----------------------------------------------------------------
@@ -464,7 +601,7 @@ bool NewAlarmDialog::showInDesktop() const
 //-----------------------------------------------------------------
 void NewAlarmDialog::setShowInKeyboard(bool value)
 {
-  m_showLogiled->setChecked(value);
+  m_showLogiled->setChecked(value && m_showLogiled->isEnabled());
 }
 
 //-----------------------------------------------------------------
@@ -476,14 +613,13 @@ bool NewAlarmDialog::showInKeyboard() const
 //-----------------------------------------------------------------
 void NewAlarmDialog::setDesktopWidgetPosition(const QPoint &position)
 {
-  for(int i = 0; i < m_widgetPositions.size(); ++i)
+  const auto index = ScreenGeometry::getInstance().positions().indexOf(position);
+  if(index > 0)
   {
-    if(position == m_widgetPositions.at(i))
-    {
-      m_positionComboBox->setCurrentIndex(i);
-      return;
-    }
+    m_positionComboBox->setCurrentIndex(index);
+    return;
   }
+
   m_positionComboBox->setCurrentIndex(0);
   m_widget.setPosition(position);
 }
@@ -509,62 +645,33 @@ const QPoint NewAlarmDialog::desktopWidgetPosition() const
 //-----------------------------------------------------------------
 void NewAlarmDialog::loadSounds()
 {
-  // NOTE: Load sound files. QSound can't play a file from the qt resource file
-  // so we will dump them first to the temporal directory, then load the resources.
-  for(int i = 0; i < soundFiles.size(); ++i)
-  {
-    auto file = QTemporaryFile::createNativeFile(soundFiles[i]);
-    m_sounds.insert(i, new QSoundEffect(this));
-    m_sounds[i]->setSource(QUrl::fromLocalFile(file->fileName()));
-
-    m_temporaryFiles << file;
-
-    connect(m_sounds[i], SIGNAL(playingChanged()),
-            this,        SLOT(setPlayButtonIcon()));
-  }
-}
-
-//-----------------------------------------------------------------
-void NewAlarmDialog::computeDesktopWidgetPositions()
-{
-  QStringList positionNames;
-
-  positionNames << tr("Custom (drag to position)");
-  m_widgetPositions << QPoint{0,0};
-
-  const auto screens = QApplication::screens();
-  computePositions(QRect{screens.at(0)->availableVirtualGeometry()}, "Global ", positionNames);
+  // shared by all the dialogs and usually decoded at startup, only the evicted sounds are decoded again.
+  // Playing a sound still being decoded starts it when ready, the dialog never waits.
+  SoundBank::getInstance().prepareAll();
 
-  for (int i = 0; i < screens.size(); ++i)
-  {
-    computePositions(screens.at(i)->availableGeometry(), QString("Monitor %1 ").arg(i), positionNames);
-  }
-
-  m_positionComboBox->insertItems(0, positionNames);
+  connect(&SoundMixer::getInstance(), SIGNAL(finished(int)),
+          this,                       SLOT(setPlayButtonIcon()));
 }
 
 //-----------------------------------------------------------------
-void NewAlarmDialog::computePositions(const QRect &rect, const QString &screenName, QStringList &positionNames)
+void NewAlarmDialog::onScreensChanged()
 {
-  auto widgetSize = DesktopWidget::WIDGET_SIZE;
+  auto &geometry = ScreenGeometry::getInstance();
 
-  for(int y: {rect.y(), rect.y()+(rect.height()-widgetSize)/2, rect.y()+rect.height()-widgetSize})
-  {
-    for(int x: {rect.x(), rect.x()+(rect.width()-widgetSize)/2, rect.x()+rect.width()-widgetSize})
-    {
-      m_widgetPositions << QPoint{x,y};
-    }
-  }
+  // the presets are shared, the combo box is only refilled when the screens change.
+  m_positionComboBox->blockSignals(true);
+  m_positionComboBox->clear();
+  m_positionComboBox->addItems(geometry.positionNames());
+  m_positionComboBox->blockSignals(false);
 
-  for(auto position: defaultPositions)
-  {
-    positionNames << screenName + position;
-  }
+  setDesktopWidgetPosition(m_widget.pos());
 }
 
 //-----------------------------------------------------------------
 void NewAlarmDialog::onKeyboardNotificationStateChanged(int value)
 {
+  if(!isVisible()) return;
+
   if(value)
   {
     auto color = m_colors.at(m_colorComboBox->currentIndex());
@@ -575,3 +682,11 @@ void NewAlarmDialog::onKeyboardNotificationStateChanged(int value)
     LogiLED::getInstance().unregisterItem("NewAlarm");
   }
 }
+
+//-----------------------------------------------------------------
+bool NewAlarmDialog::isColorAvailable(int index) const
+{
+  auto model = qobject_cast<QStandardItemModel *>(m_colorComboBox->model());
+
+  return model->item(index)->isEnabled();
+}
@@ -22,17 +22,17 @@
 
 // Project
 #include "ui_NewAlarmDialog.h"
+#include <AlarmConfiguration.h>
 #include <DesktopWidget.h>
 
 // Qt
 #include <QDialog>
 
-class QSoundEffect;
-class QTemporaryFile;
-class QRect;
+class QShowEvent;
 
 /** \class NewAlarmDialog
- * \brief Dialog for the creation of an alarm.
+ * \brief Dialog for the creation and modification of an alarm. A single instance is created on startup
+ *        and reused, setConfiguration() resets it before showing it.
  *
  */
 class NewAlarmDialog
@@ -46,13 +46,29 @@ class NewAlarmDialog
      * \param[in] flags window flags.
      *
      */
-    NewAlarmDialog(QStringList invalidNames, QStringList invalidColors, QWidget * parent = nullptr, Qt::WindowFlags f = Qt::WindowFlags());
+    explicit NewAlarmDialog(QWidget * parent = nullptr, Qt::WindowFlags f = Qt::WindowFlags());
 
     /** \brief NewAlarmDialog class virtual destructor.
      *
      */
     virtual ~NewAlarmDialog();
 
+    /** \brief Resets the dialog to the values of the alarm. Invalid times are replaced by the minimum
+     *         timer time and the current date, an empty or used color by the first available one.
+     * \param[in] conf alarm configuration.
+     * \param[in] invalidNames names already in use, the alarm name must be unique.
+     * \param[in] invalidColors colors already in use, shown disabled.
+     * \param[in] groups existing group names.
+     *
+     */
+    void setConfiguration(const AlarmConfiguration &conf, const QStringList &invalidNames,
+                          const QStringList &invalidColors, const QStringList &groups);
+
+    /** \brief Returns the alarm configuration of the dialog values.
+     *
+     */
+    const AlarmConfiguration configuration() const;
+
     /** \brief Sets the name/identificator of the alarm.
      *
      */
@@ -74,6 +90,23 @@ class NewAlarmDialog
      */
     const QString message() const;
 
+    /** \brief Sets the list of existing groups to choose from.
+     * \param[in] groups group names.
+     *
+     */
+    void setGroups(const QStringList &groups);
+
+    /** \brief Sets the group of the alarm.
+     * \param[in] group group name, empty for no group.
+     *
+     */
+    void setGroup(const QString &group);
+
+    /** \brief Returns the group of the alarm, empty if the alarm is not grouped.
+     *
+     */
+    const QString group() const;
+
     /** \brief Returns true if the alarm is a timer, otherwise is a clock.
      *
      */
@@ -135,11 +168,23 @@ class NewAlarmDialog
      */
     void setSound(int soundIndex);
 
-    /** \brief Returns the index of the selected sound for the alarm.
+    /** \brief Returns the index of the selected sound for the alarm, or of the last embedded sound selected
+     *         if the alarm uses a sound file.
      *
      */
     int sound() const;
 
+    /** \brief Sets the sound file to be played when the alarm finishes, instead of the sound.
+     * \param[in] file sound file path, empty to use the sound.
+     *
+     */
+    void setSoundFile(const QString &file);
+
+    /** \brief Returns the selected sound file, or an empty string if the alarm uses an embedded sound.
+     *
+     */
+    const QString soundFile() const;
+
     /** \brief Sets the value of the volume.
      * \param[in] value int value in [0-100]
      *
@@ -252,7 +297,7 @@ class NewAlarmDialog
      */
     void playSound();
 
-    /** \brief Restores the icon of the play button when a sound finishes playing.
+    /** \brief Updates the icon of the play button when the preview sound starts or finishes playing.
      *
      */
     void setPlayButtonIcon();
@@ -268,42 +313,54 @@ class NewAlarmDialog
      */
     void onVolumeChanged(int value);
 
+    /** \brief Asks for a sound file when the sound file item is selected.
+     * \param[in] index sound combo box index.
+     *
+     */
+    void onSoundActivated(int index);
+
     /** \brief Shows/hides the keyboard lights for the alarm when the checkbox changes state.
      * \param[in] value Checkbox state.
      */
     void onKeyboardNotificationStateChanged(int value);
 
+    /** \brief Fills the desktop widget position combo box with the preset positions of the screens.
+     *
+     */
+    void onScreensChanged();
+
+  protected:
+    virtual void showEvent(QShowEvent *e) override;
+
+    /** \brief Stops the preview and hides the preview widget and lights, the dialog is reused.
+     * \param[in] result dialog result.
+     *
+     */
+    virtual void done(int result) override;
+
   private:
     /** \brief Helper methods to connect the signals for UI elements.
      *
      */
     void connectSignals();
 
-    /** \brief Loads the sounds into the sounds vector.
+    /** \brief Starts decoding the sounds in the background.
      *
      */
     void loadSounds();
 
-    /** \brief Fills the desktop widget position combo box with all the
-     * posible pre-set positions based on detected screen geometry.
-     *
-     */
-    void computeDesktopWidgetPositions();
-
-    /** \brief Computes all the fixed positions and position names for the given QRect.
-     * \param[in] rect QRect rectangle.
-     * \param[in] screenName name of the screen.
-     * \param[out] positionNames list of position names.
+    /** \brief Returns true if the color of the combo box index isn't used by other alarm.
+     * \param[in] index color combo box index.
      *
      */
-    void computePositions(const QRect &rect, const QString &screenName, QStringList &positionNames);
+    bool isColorAvailable(int index) const;
 
-    QVector<QSoundEffect *> m_sounds;          /** Desktop widgets sounds list.                                    */
-    QList<QTemporaryFile *> m_temporaryFiles;  /** Desktop sounds temporary files in system's temporary directory. */
+    int                     m_preview;         /** Preview sound playback identifier, -1 if not playing.          */
+    int                     m_soundIndex;      /** Last embedded sound selected.                                   */
+    QString                 m_soundFile;       /** Sound file selected, empty if none.                             */
     QStringList             m_invalidNames;    /** List of current alarm names. Alarm name must be unique.         */
-    QStringList             m_colors;          /** List of current alarm colors. Alarm color must be unique.       */
+    QStringList             m_colors;          /** List of colors of the color combo box, the used ones disabled.  */
     DesktopWidget           m_widget;          /** Desktop widget for the alarm.                                   */
-    QList<QPoint>           m_widgetPositions; /** List of default defined desktop widget positions.               */
 };
 
 #endif // NEWALARMDIALOG_H_
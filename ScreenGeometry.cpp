@@ -0,0 +1,158 @@
+/*
+ File: ScreenGeometry.cpp
+ Created on: 19/10/2026
+ Author: Felix de las Pozas Alvarez
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Project
+#include <ScreenGeometry.h>
+#include <DesktopWidget.h>
+
+// Qt
+#include <QGuiApplication>
+#include <QScreen>
+
+const QStringList defaultPositions = { "Top Left",
+                                       "Top Center",
+                                       "Top Right",
+                                       "Center Left",
+                                       "Center",
+                                       "Center Right",
+                                       "Bottom Left",
+                                       "Bottom Center",
+                                       "Bottom Right" };
+
+//-----------------------------------------------------------------
+ScreenGeometry& ScreenGeometry::getInstance()
+{
+  static ScreenGeometry instance;
+
+  return instance;
+}
+
+//-----------------------------------------------------------------
+ScreenGeometry::ScreenGeometry()
+: QObject{nullptr}
+{
+  for(auto screen: QGuiApplication::screens())
+  {
+    m_screens.insert(screen, presets(screen->availableGeometry()));
+
+    connect(screen, SIGNAL(availableGeometryChanged(const QRect &)),
+            this,   SLOT(onScreenChanged()));
+  }
+
+  connect(qApp, SIGNAL(screenAdded(QScreen *)),
+          this, SLOT(onScreenAdded(QScreen *)));
+
+  connect(qApp, SIGNAL(screenRemoved(QScreen *)),
+          this, SLOT(onScreenRemoved(QScreen *)));
+
+  connect(qApp, SIGNAL(primaryScreenChanged(QScreen *)),
+          this, SLOT(onScreenChanged()));
+
+  update();
+}
+
+//-----------------------------------------------------------------
+QPoint ScreenGeometry::clamp(const QPoint &position) const
+{
+  const auto limitX = qMax(m_desktop.x(), m_desktop.x() + m_desktop.width() - DesktopWidget::WIDGET_SIZE);
+  const auto limitY = qMax(m_desktop.y(), m_desktop.y() + m_desktop.height() - DesktopWidget::WIDGET_SIZE);
+
+  return QPoint{qBound(m_desktop.x(), position.x(), limitX), qBound(m_desktop.y(), position.y(), limitY)};
+}
+
+//-----------------------------------------------------------------
+void ScreenGeometry::onScreenAdded(QScreen *screen)
+{
+  m_screens.insert(screen, presets(screen->availableGeometry()));
+
+  connect(screen, SIGNAL(availableGeometryChanged(const QRect &)),
+          this,   SLOT(onScreenChanged()));
+
+  update();
+}
+
+//-----------------------------------------------------------------
+void ScreenGeometry::onScreenRemoved(QScreen *screen)
+{
+  m_screens.remove(screen);
+
+  update();
+}
+
+//-----------------------------------------------------------------
+void ScreenGeometry::onScreenChanged()
+{
+  auto screen = qobject_cast<QScreen *>(sender());
+  if(screen && m_screens.contains(screen))
+  {
+    m_screens.insert(screen, presets(screen->availableGeometry()));
+  }
+
+  update();
+}
+
+//-----------------------------------------------------------------
+QList<QPoint> ScreenGeometry::presets(const QRect &rect)
+{
+  const auto widgetSize = DesktopWidget::WIDGET_SIZE;
+
+  QList<QPoint> result;
+  for(int y: {rect.y(), rect.y()+(rect.height()-widgetSize)/2, rect.y()+rect.height()-widgetSize})
+  {
+    for(int x: {rect.x(), rect.x()+(rect.width()-widgetSize)/2, rect.x()+rect.width()-widgetSize})
+    {
+      result << QPoint{x,y};
+    }
+  }
+
+  return result;
+}
+
+//-----------------------------------------------------------------
+void ScreenGeometry::update()
+{
+  m_positions.clear();
+  m_names.clear();
+
+  m_positions << QPoint{0,0};
+  m_names << tr("Custom (drag to position)");
+
+  auto primary = QGuiApplication::primaryScreen();
+  const auto desktop = primary ? primary->availableVirtualGeometry() : QRect();
+
+  // only the joined lists are rebuilt, the presets of the unchanged screens are reused.
+  if(desktop.isValid())
+  {
+    m_positions << presets(desktop);
+    for(const auto &position: defaultPositions) m_names << "Global " + position;
+  }
+
+  const auto screens = QGuiApplication::screens();
+  for(int i = 0; i < screens.size(); ++i)
+  {
+    if(!m_screens.contains(screens.at(i))) continue;
+
+    m_positions << m_screens.value(screens.at(i));
+    for(const auto &position: defaultPositions) m_names << QString("Monitor %1 ").arg(i) + position;
+  }
+
+  m_desktop = desktop;
+
+  emit changed();
+}
@@ -0,0 +1,131 @@
+/*
+ File: ScreenGeometry.h
+ Created on: 19/10/2026
+ Author: Felix de las Pozas Alvarez
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SCREENGEOMETRY_H_
+#define SCREENGEOMETRY_H_
+
+// Qt
+#include <QObject>
+#include <QStringList>
+#include <QList>
+#include <QPoint>
+#include <QRect>
+#include <QMap>
+
+class QScreen;
+
+/** \class ScreenGeometry
+ * \brief Process-wide cache of the desktop widget preset positions and clamping limits. The presets
+ *        of each screen are computed once and updated only when a screen is added, removed or changes
+ *        its geometry.
+ *
+ */
+class ScreenGeometry
+: public QObject
+{
+    Q_OBJECT
+  public:
+    /** \brief Gets the ScreenGeometry singleton instance.
+     *
+     */
+    static ScreenGeometry &getInstance();
+
+    /** \brief Deleted copy constructor to avoid copying the singleton.
+     *
+     */
+    ScreenGeometry(ScreenGeometry const&) = delete;
+
+    /** \brief Deleted operator= to avoid copying the singleton.
+     *
+     */
+    void operator=(ScreenGeometry const&) = delete;
+
+    /** \brief Returns the preset positions of the desktop widget. The first one is the custom position,
+     *         followed by nine for the whole desktop and nine for each screen.
+     *
+     */
+    const QList<QPoint> &positions() const
+    { return m_positions; }
+
+    /** \brief Returns the names of the preset positions, in the same order.
+     *
+     */
+    const QStringList &positionNames() const
+    { return m_names; }
+
+    /** \brief Returns the position moved inside the desktop so the whole widget is visible.
+     * \param[in] position widget position in global coordinates.
+     *
+     */
+    QPoint clamp(const QPoint &position) const;
+
+  signals:
+    /** \brief Signals a change of the preset positions and limits.
+     *
+     */
+    void changed();
+
+  private slots:
+    /** \brief Computes the presets of the new screen.
+     * \param[in] screen added screen.
+     *
+     */
+    void onScreenAdded(QScreen *screen);
+
+    /** \brief Removes the presets of the screen.
+     * \param[in] screen removed screen.
+     *
+     */
+    void onScreenRemoved(QScreen *screen);
+
+    /** \brief Computes again the presets of the sender screen and the desktop limits.
+     *
+     */
+    void onScreenChanged();
+
+  private:
+    /** \brief ScreenGeometry class private constructor.
+     *
+     */
+    ScreenGeometry();
+
+    /** \brief ScreenGeometry class private destructor.
+     *
+     */
+    virtual ~ScreenGeometry()
+    {};
+
+    /** \brief Returns the nine preset positions of the rectangle, by rows from the top left corner.
+     * \param[in] rect QRect rectangle.
+     *
+     */
+    static QList<QPoint> presets(const QRect &rect);
+
+    /** \brief Computes the desktop presets and limits and joins the presets of all the screens.
+     *
+     */
+    void update();
+
+    QMap<QScreen *, QList<QPoint>> m_screens;   /** preset positions of each screen.           */
+    QRect                          m_desktop;   /** available desktop, in global coordinates.  */
+    QList<QPoint>                  m_positions; /** all preset positions.                      */
+    QStringList                    m_names;     /** names of the preset positions.             */
+};
+
+#endif // SCREENGEOMETRY_H_
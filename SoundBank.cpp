@@ -0,0 +1,315 @@
+/*
+ File: SoundBank.cpp
+ Created on: 19/10/2026
+ Author: Felix de las Pozas Alvarez
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Project
+#include <SoundBank.h>
+#include <SoundMixer.h>
+#include <SoundDecoder.h>
+
+// Qt
+#include <QThreadPool>
+#include <QtEndian>
+#include <QFile>
+#include <QDebug>
+
+// C++
+#include <algorithm>
+
+const QStringList SOUND_FILES = { ":/MultiAlarm/sounds/Beeper 1.wav",
+                                  ":/MultiAlarm/sounds/Beeper 2.wav",
+                                  ":/MultiAlarm/sounds/Beeper 3.wav",
+                                  ":/MultiAlarm/sounds/Buzzer 1.wav",
+                                  ":/MultiAlarm/sounds/Buzzer 2.wav",
+                                  ":/MultiAlarm/sounds/Code Red.wav",
+                                  ":/MultiAlarm/sounds/Electronic.wav",
+                                  ":/MultiAlarm/sounds/Pager.wav",
+                                  ":/MultiAlarm/sounds/Smoke.wav" };
+
+const QStringList SOUND_NAMES = { "Beeper 1",
+                                  "Beeper 2",
+                                  "Beeper 3",
+                                  "Buzzer 1",
+                                  "Buzzer 2",
+                                  "Code Red",
+                                  "Electronic",
+                                  "Pager",
+                                  "Smoke Alarm" };
+
+const quint16 WAVE_PCM        = 1;
+const quint16 WAVE_FLOAT      = 3;
+const quint16 WAVE_EXTENSIBLE = 0xFFFE;
+
+const qint64 DEFAULT_CACHE_LIMIT = 64*1024*1024; // bytes of decoded sounds.
+
+//-----------------------------------------------------------------
+SoundBank& SoundBank::getInstance()
+{
+  static SoundBank instance;
+
+  return instance;
+}
+
+//-----------------------------------------------------------------
+SoundBank::SoundBank()
+: QObject     {nullptr}
+, m_sampleRate{SoundMixer::getInstance().sampleRate()}
+, m_cache     {DEFAULT_CACHE_LIMIT}
+, m_decoder   {nullptr}
+{
+  qRegisterMetaType<QVector<float>>("QVector<float>");
+
+  // the mixer completes the voices of the sounds that weren't ready when played.
+  connect(this,                       SIGNAL(soundReady(const QString &)),
+          &SoundMixer::getInstance(), SLOT(onSoundReady(const QString &)));
+
+  connect(this,                       SIGNAL(soundFailed(const QString &)),
+          &SoundMixer::getInstance(), SLOT(onSoundFailed(const QString &)));
+}
+
+//-----------------------------------------------------------------
+SoundBank::~SoundBank()
+{
+  clear();
+}
+
+//-----------------------------------------------------------------
+int SoundBank::count()
+{
+  return SOUND_FILES.size();
+}
+
+//-----------------------------------------------------------------
+const QStringList SoundBank::names()
+{
+  return SOUND_NAMES;
+}
+
+//-----------------------------------------------------------------
+QString SoundBank::source(int sound)
+{
+  return SOUND_FILES.at(qBound(0, sound, count() - 1));
+}
+
+//-----------------------------------------------------------------
+QString SoundBank::source(const AlarmConfiguration &conf)
+{
+  return conf.soundFile.isEmpty() ? source(conf.sound) : conf.soundFile;
+}
+
+//-----------------------------------------------------------------
+bool SoundBank::isEmbedded(const QString &source)
+{
+  return source.startsWith(":/");
+}
+
+//-----------------------------------------------------------------
+void SoundBank::prepare(const QString &source)
+{
+  if(source.isEmpty() || m_cache.contains(source) || m_decoding.contains(source)) return;
+
+  m_decoding.insert(source);
+
+  if(isEmbedded(source))
+  {
+    const auto sampleRate = m_sampleRate;
+    QThreadPool::globalInstance()->start([this, source, sampleRate]()
+    {
+      const auto samples = decodeWav(source, sampleRate);
+
+      QMetaObject::invokeMethod(this, [this, source, samples]() { onDecoded(source, samples); }, Qt::QueuedConnection);
+    });
+
+    return;
+  }
+
+  // user files can be long and compressed, they are decoded one at a time in their own thread.
+  if(!m_decoder)
+  {
+    m_decoder = new SoundDecoder(m_sampleRate, m_cache.maxCost());
+    m_decoder->moveToThread(&m_thread);
+
+    connect(&m_thread, SIGNAL(finished()),
+            m_decoder, SLOT(deleteLater()));
+
+    connect(m_decoder, SIGNAL(decoded(const QString &, const QVector<float> &)),
+            this,      SLOT(onDecoded(const QString &, const QVector<float> &)));
+
+    m_thread.start(QThread::LowPriority);
+  }
+
+  m_decoder->decode(source);
+}
+
+//-----------------------------------------------------------------
+void SoundBank::prepareAll()
+{
+  for(const auto &source: SOUND_FILES)
+    prepare(source);
+}
+
+//-----------------------------------------------------------------
+bool SoundBank::isReady(const QString &source) const
+{
+  return m_cache.contains(source);
+}
+
+//-----------------------------------------------------------------
+bool SoundBank::isDecoding(const QString &source) const
+{
+  return m_decoding.contains(source);
+}
+
+//-----------------------------------------------------------------
+const QVector<float> SoundBank::samples(const QString &source)
+{
+  if(auto cached = m_cache.object(source))
+    return *cached;
+
+  // not decoded twice, the caller waits for soundReady() instead.
+  if(!isEmbedded(source) || isDecoding(source))
+  {
+    prepare(source);
+    return QVector<float>();
+  }
+
+  // an alarm timing out before its sound has been decoded in the background, or evicted.
+  onDecoded(source, decodeWav(source, m_sampleRate));
+
+  auto cached = m_cache.object(source);
+  return cached ? *cached : QVector<float>();
+}
+
+//-----------------------------------------------------------------
+void SoundBank::setCacheLimit(qint64 bytes)
+{
+  m_cache.setMaxCost(bytes);
+}
+
+//-----------------------------------------------------------------
+void SoundBank::clear()
+{
+  if(m_decoder)
+  {
+    m_thread.quit();
+    m_thread.wait();
+    m_decoder = nullptr;
+  }
+
+  m_cache.clear();
+  m_decoding.clear();
+}
+
+//-----------------------------------------------------------------
+QVector<float> SoundBank::decodeWav(const QString &source, int sampleRate)
+{
+  QFile file(source);
+  if(!file.open(QFile::ReadOnly)) return QVector<float>();
+
+  const auto data = file.readAll();
+  const auto bytes = reinterpret_cast<const uchar *>(data.constData());
+
+  if(data.size() < 12 || !data.startsWith("RIFF") || data.mid(8, 4) != "WAVE") return QVector<float>();
+
+  quint16 format = 0, channels = 0, bits = 0;
+  quint32 rate = 0;
+  qsizetype dataStart = -1, dataSize = 0;
+
+  // chunks are word aligned.
+  for(qsizetype position = 12; position + 8 <= data.size();)
+  {
+    const auto id   = data.mid(position, 4);
+    const auto size = static_cast<qsizetype>(qFromLittleEndian<quint32>(bytes + position + 4));
+    const auto body = position + 8;
+
+    if(id == "fmt " && size >= 16 && body + 16 <= data.size())
+    {
+      format   = qFromLittleEndian<quint16>(bytes + body);
+      channels = qFromLittleEndian<quint16>(bytes + body + 2);
+      rate     = qFromLittleEndian<quint32>(bytes + body + 4);
+      bits     = qFromLittleEndian<quint16>(bytes + body + 14);
+
+      if(format == WAVE_EXTENSIBLE && size >= 26 && body + 26 <= data.size())
+        format = qFromLittleEndian<quint16>(bytes + body + 24);
+    }
+    else if(id == "data")
+    {
+      dataStart = body;
+      dataSize  = std::min(size, data.size() - body);
+    }
+
+    position = body + size + (size & 1);
+  }
+
+  const bool valid = (format == WAVE_PCM && (bits == 8 || bits == 16 || bits == 24 || bits == 32)) ||
+                     (format == WAVE_FLOAT && bits == 32);
+
+  if(!valid || channels == 0 || rate == 0 || dataStart < 0)
+  {
+    qWarning() << "Unsupported WAV format in" << source;
+    return QVector<float>();
+  }
+
+  const int sampleSize = bits / 8;
+  const qsizetype frames = dataSize / (sampleSize * channels);
+
+  auto sampleAt = [&](qsizetype frame, int channel)
+  {
+    const auto p = bytes + dataStart + (frame * channels + std::min<int>(channel, channels - 1)) * sampleSize;
+    switch(bits)
+    {
+      case 8:  return (static_cast<int>(*p) - 128) / 128.f;
+      case 16: return qFromLittleEndian<qint16>(p) / 32768.f;
+      case 24: return static_cast<qint32>(quint32(p[0]) << 8 | quint32(p[1]) << 16 | quint32(p[2]) << 24) / 2147483648.f;
+      default: break;
+    }
+
+    if(format == WAVE_FLOAT)
+      return qFromLittleEndian<float>(p);
+
+    return qFromLittleEndian<qint32>(p) / 2147483648.f;
+  };
+
+  if(frames == 0) return QVector<float>();
+
+  // a mono sound goes to both channels.
+  QVector<float> result(frames * 2);
+  for(qsizetype frame = 0; frame < frames; ++frame)
+  {
+    result[frame * 2]     = sampleAt(frame, 0);
+    result[frame * 2 + 1] = sampleAt(frame, 1);
+  }
+
+  return SoundDecoder::resample(result, rate, sampleRate);
+}
+
+//-----------------------------------------------------------------
+void SoundBank::onDecoded(const QString &source, const QVector<float> &samples)
+{
+  m_decoding.remove(source);
+
+  // the cache takes ownership of the copy, the voices playing an evicted sound keep their own.
+  if(samples.isEmpty() || !m_cache.insert(source, new QVector<float>(samples), samples.size() * sizeof(float)))
+  {
+    qWarning() << "Unable to load sound" << source;
+    emit soundFailed(source);
+    return;
+  }
+
+  emit soundReady(source);
+}
@@ -0,0 +1,174 @@
+/*
+ File: SoundBank.h
+ Created on: 19/10/2026
+ Author: Felix de las Pozas Alvarez
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SOUNDBANK_H_
+#define SOUNDBANK_H_
+
+// Project
+#include <AlarmConfiguration.h>
+
+// Qt
+#include <QObject>
+#include <QStringList>
+#include <QVector>
+#include <QCache>
+#include <QThread>
+#include <QSet>
+
+class SoundDecoder;
+
+/** \class SoundBank
+ * \brief Process-wide store of the alarm sounds, decoded in the background to the PCM format of the
+ *        SoundMixer, interleaved stereo float samples. A sound is identified by its source, the Qt
+ *        resource of an embedded sound or the path of a user file. The decoded sounds are kept in a
+ *        cache limited in size that drops the least recently used ones.
+ *
+ */
+class SoundBank
+: public QObject
+{
+    Q_OBJECT
+  public:
+    /** \brief Gets the SoundBank singleton instance.
+     *
+     */
+    static SoundBank &getInstance();
+
+    /** \brief Deleted copy constructor to avoid copying the singleton.
+     *
+     */
+    SoundBank(SoundBank const&) = delete;
+
+    /** \brief Deleted operator= to avoid copying the singleton.
+     *
+     */
+    void operator=(SoundBank const&) = delete;
+
+    /** \brief Returns the number of embedded sounds.
+     *
+     */
+    static int count();
+
+    /** \brief Returns the names of the embedded sounds.
+     *
+     */
+    static const QStringList names();
+
+    /** \brief Returns the source of the embedded sound.
+     * \param[in] sound embedded sound index.
+     *
+     */
+    static QString source(int sound);
+
+    /** \brief Returns the source of the sound of the alarm, its sound file if it has one.
+     * \param[in] conf alarm configuration.
+     *
+     */
+    static QString source(const AlarmConfiguration &conf);
+
+    /** \brief Returns true if the source is an embedded sound and false if it's a user file.
+     * \param[in] source sound source.
+     *
+     */
+    static bool isEmbedded(const QString &source);
+
+    /** \brief Decodes the sound in the background, if not already done. Emits soundReady() or
+     *         soundFailed() when finished.
+     * \param[in] source sound source.
+     *
+     */
+    void prepare(const QString &source);
+
+    /** \brief Decodes all the embedded sounds in the background, if not already done.
+     *
+     */
+    void prepareAll();
+
+    /** \brief Returns true if the sound is decoded and in the cache.
+     * \param[in] source sound source.
+     *
+     */
+    bool isReady(const QString &source) const;
+
+    /** \brief Returns true if the sound is being decoded in the background.
+     * \param[in] source sound source.
+     *
+     */
+    bool isDecoding(const QString &source) const;
+
+    /** \brief Returns the samples of the sound at the mixer sample rate. An embedded sound not in the cache
+     *         nor being decoded is decoded before returning. Otherwise the sound is prepared and an empty
+     *         vector returned, soundReady() signals when it can be played. Returns an empty vector on error.
+     * \param[in] source sound source.
+     *
+     */
+    const QVector<float> samples(const QString &source);
+
+    /** \brief Sets the maximum size of the decoded sounds in the cache. User files decoded to a bigger size
+     *         are rejected. Must be set before decoding user files.
+     * \param[in] bytes cache size in bytes.
+     *
+     */
+    void setCacheLimit(qint64 bytes);
+
+    /** \brief Stops the decoding thread and empties the cache. Must be called before the application
+     *         is destroyed.
+     *
+     */
+    void clear();
+
+  signals:
+    void soundReady(const QString &source);
+    void soundFailed(const QString &source);
+
+  private slots:
+    /** \brief Stores the decoded samples of the sound.
+     * \param[in] source sound source.
+     * \param[in] samples decoded samples, empty on error.
+     *
+     */
+    void onDecoded(const QString &source, const QVector<float> &samples);
+
+  private:
+    /** \brief SoundBank class private constructor.
+     *
+     */
+    SoundBank();
+
+    /** \brief SoundBank class private destructor.
+     *
+     */
+    virtual ~SoundBank();
+
+    /** \brief Decodes the WAV resource to interleaved stereo samples at the given sample rate. Returns an
+     *         empty vector on error. Can be called from any thread.
+     * \param[in] source embedded sound source.
+     * \param[in] sampleRate sample rate of the result.
+     *
+     */
+    static QVector<float> decodeWav(const QString &source, int sampleRate);
+
+    const int                        m_sampleRate; /** sample rate of the decoded sounds.                  */
+    QCache<QString, QVector<float>>  m_cache;      /** decoded sounds, the cost is the size in bytes.      */
+    QSet<QString>                    m_decoding;   /** sources being decoded.                              */
+    QThread                          m_thread;     /** user files decoding thread.                         */
+    SoundDecoder                    *m_decoder;    /** user files decoder, created on first use.           */
+};
+
+#endif // SOUNDBANK_H_
@@ -0,0 +1,174 @@
+/*
+ File: SoundDecoder.cpp
+ Created on: 19/10/2026
+ Author: Felix de las Pozas Alvarez
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Project
+#include <SoundDecoder.h>
+
+// Qt
+#include <QAudioBuffer>
+#include <QUrl>
+#include <QDebug>
+
+// C++
+#include <algorithm>
+#include <cmath>
+
+//-----------------------------------------------------------------
+SoundDecoder::SoundDecoder(int sampleRate, qint64 limit)
+: QObject     {nullptr}
+, m_sampleRate{sampleRate}
+, m_limit     {limit}
+, m_decoder   {this}
+, m_rate      {0}
+{
+  // a request, the backend may decode to a different format.
+  QAudioFormat format;
+  format.setSampleRate(sampleRate);
+  format.setChannelCount(2);
+  format.setSampleFormat(QAudioFormat::Float);
+  m_decoder.setAudioFormat(format);
+
+  connect(&m_decoder, SIGNAL(bufferReady()),
+          this,       SLOT(onBufferReady()));
+
+  connect(&m_decoder, SIGNAL(finished()),
+          this,       SLOT(onFinished()));
+
+  connect(&m_decoder, SIGNAL(error(QAudioDecoder::Error)),
+          this,       SLOT(onError(QAudioDecoder::Error)));
+}
+
+//-----------------------------------------------------------------
+void SoundDecoder::decode(const QString &path)
+{
+  QMetaObject::invokeMethod(this, [this, path]()
+  {
+    if(path != m_current && !m_queue.contains(path))
+      m_queue << path;
+
+    next();
+  }, Qt::QueuedConnection);
+}
+
+//-----------------------------------------------------------------
+void SoundDecoder::next()
+{
+  if(!m_current.isEmpty() || m_queue.isEmpty()) return;
+
+  m_current = m_queue.takeFirst();
+  m_samples.clear();
+  m_rate = 0;
+
+  m_decoder.setSource(QUrl::fromLocalFile(m_current));
+  m_decoder.start();
+}
+
+//-----------------------------------------------------------------
+void SoundDecoder::onBufferReady()
+{
+  const auto buffer = m_decoder.read();
+  if(!buffer.isValid() || m_current.isEmpty()) return;
+
+  const auto format   = buffer.format();
+  const auto channels = format.channelCount();
+  const auto frames   = buffer.frameCount();
+  const auto stride   = format.bytesPerSample();
+  const auto data     = buffer.constData<char>();
+
+  if(channels <= 0) return;
+
+  m_rate = format.sampleRate();
+
+  // a mono sound goes to both channels, channels beyond the second are dropped.
+  const auto offset = m_samples.size();
+  m_samples.resize(offset + frames * 2);
+  auto samples = m_samples.data() + offset;
+
+  for(qsizetype frame = 0; frame < frames; ++frame)
+  {
+    const auto base = data + frame * format.bytesPerFrame();
+    samples[frame * 2]     = format.normalizedSampleValue(base);
+    samples[frame * 2 + 1] = format.normalizedSampleValue(base + (channels > 1 ? stride : 0));
+  }
+
+  // the size at the output rate is checked, the cache couldn't hold a longer sound anyway.
+  const auto outputSize = static_cast<qint64>(m_samples.size() * sizeof(float) * (static_cast<double>(m_sampleRate) / m_rate));
+  if(outputSize > m_limit)
+  {
+    qWarning() << "Sound file" << m_current << "exceeds the sound cache size when decoded.";
+    m_decoder.stop();
+    finish(QVector<float>());
+  }
+}
+
+//-----------------------------------------------------------------
+void SoundDecoder::onFinished()
+{
+  if(m_current.isEmpty()) return;
+
+  finish(m_rate > 0 ? resample(m_samples, m_rate, m_sampleRate) : QVector<float>());
+}
+
+//-----------------------------------------------------------------
+void SoundDecoder::onError(QAudioDecoder::Error error)
+{
+  if(m_current.isEmpty()) return;
+
+  qWarning() << "Unable to decode sound file" << m_current << error << m_decoder.errorString();
+  m_decoder.stop();
+  finish(QVector<float>());
+}
+
+//-----------------------------------------------------------------
+void SoundDecoder::finish(const QVector<float> &samples)
+{
+  const auto path = m_current;
+
+  m_current.clear();
+  m_samples.clear();
+
+  emit decoded(path, samples);
+
+  // the signals of a stopped decoding already queued are ignored before starting the next file.
+  QMetaObject::invokeMethod(this, [this]() { next(); }, Qt::QueuedConnection);
+}
+
+//-----------------------------------------------------------------
+QVector<float> SoundDecoder::resample(const QVector<float> &samples, int from, int to)
+{
+  if(from == to || samples.size() < 2) return samples;
+
+  const qsizetype frames = samples.size() / 2;
+  const double step = static_cast<double>(from) / to;
+  const qsizetype resultFrames = std::max<qsizetype>(1, std::floor((frames - 1) / step) + 1);
+
+  QVector<float> result(resultFrames * 2);
+  for(qsizetype i = 0; i < resultFrames; ++i)
+  {
+    const double position = i * step;
+    const auto frame = static_cast<qsizetype>(position);
+    const auto next  = std::min(frame + 1, frames - 1);
+    const auto t     = static_cast<float>(position - frame);
+
+    for(int channel: {0, 1})
+      result[i * 2 + channel] = samples[frame * 2 + channel] * (1.f - t) + samples[next * 2 + channel] * t;
+  }
+
+  return result;
+}
@@ -0,0 +1,114 @@
+/*
+ File: SoundDecoder.h
+ Created on: 19/10/2026
+ Author: Felix de las Pozas Alvarez
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SOUNDDECODER_H_
+#define SOUNDDECODER_H_
+
+// Qt
+#include <QObject>
+#include <QAudioDecoder>
+#include <QStringList>
+#include <QVector>
+
+/** \class SoundDecoder
+ * \brief Decodes user audio files with QAudioDecoder, one at a time, to interleaved stereo float
+ *        samples. Lives in the sound bank thread so long files don't stall the GUI.
+ *
+ *        decode() can be called from any thread, the work is queued to the decoder thread.
+ *
+ */
+class SoundDecoder
+: public QObject
+{
+    Q_OBJECT
+  public:
+    /** \brief SoundDecoder class constructor.
+     * \param[in] sampleRate sample rate of the decoded samples.
+     * \param[in] limit maximum size of the decoded samples in bytes, longer files are rejected.
+     *
+     */
+    explicit SoundDecoder(int sampleRate, qint64 limit);
+
+    /** \brief SoundDecoder class virtual destructor.
+     *
+     */
+    virtual ~SoundDecoder()
+    {};
+
+    /** \brief Queues the file for decoding. Emits decoded() when finished.
+     * \param[in] path audio file path.
+     *
+     */
+    void decode(const QString &path);
+
+    /** \brief Returns the samples resampled from one sample rate to another, with linear interpolation.
+     * \param[in] samples interleaved stereo samples.
+     * \param[in] from sample rate of the samples.
+     * \param[in] to sample rate of the result.
+     *
+     */
+    static QVector<float> resample(const QVector<float> &samples, int from, int to);
+
+  signals:
+    /** \brief Signals the end of the decoding of a file.
+     * \param[out] path audio file path.
+     * \param[out] samples decoded samples, empty on error.
+     *
+     */
+    void decoded(const QString &path, const QVector<float> &samples);
+
+  private slots:
+    /** \brief Converts the available buffer to stereo float samples.
+     *
+     */
+    void onBufferReady();
+
+    /** \brief Emits the decoded samples and starts the next file.
+     *
+     */
+    void onFinished();
+
+    /** \brief Emits the decoding failure and starts the next file.
+     * \param[in] error decoder error.
+     *
+     */
+    void onError(QAudioDecoder::Error error);
+
+  private:
+    /** \brief Starts decoding the next queued file, if not busy.
+     *
+     */
+    void next();
+
+    /** \brief Emits the result of the current file and starts the next one.
+     * \param[in] samples decoded samples, empty on error.
+     *
+     */
+    void finish(const QVector<float> &samples);
+
+    const int      m_sampleRate; /** sample rate of the decoded samples.           */
+    const qint64   m_limit;      /** maximum size of the decoded samples in bytes. */
+    QAudioDecoder  m_decoder;    /** audio decoder.                                */
+    QStringList    m_queue;      /** files waiting to be decoded.                  */
+    QString        m_current;    /** file being decoded, empty if idle.            */
+    QVector<float> m_samples;    /** samples of the current file.                  */
+    int            m_rate;       /** sample rate of the current file.              */
+};
+
+#endif // SOUNDDECODER_H_
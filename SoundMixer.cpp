@@ -0,0 +1,332 @@
+/*
+ File: SoundMixer.cpp
+ Created on: 19/10/2026
+ Author: Felix de las Pozas Alvarez
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Project
+#include <SoundMixer.h>
+#include <SoundBank.h>
+
+// Qt
+#include <QAudioSink>
+#include <QMediaDevices>
+#include <QAudioDevice>
+
+// C++
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+const int MAX_VOICES            = 4;       // voices mixed at once, the quietest ones are muted.
+const int DEFAULT_SAMPLE_RATE   = 48000;   // used when the output device doesn't have a preferred format.
+const qint64 BUFFER_DURATION    = 100000;  // microseconds of audio buffered by the output.
+const float LIMITER_RELEASE     = 0.9998f; // per frame decay of the limiter envelope, about 100 ms.
+
+const char *OUTPUT_VARIABLE = "MULTIALARM_AUDIO_OUTPUT";
+
+//-----------------------------------------------------------------
+SoundMixer& SoundMixer::getInstance()
+{
+  static SoundMixer instance;
+
+  return instance;
+}
+
+//-----------------------------------------------------------------
+SoundMixer::SoundMixer()
+: QIODevice {nullptr}
+, m_output  {qEnvironmentVariable(OUTPUT_VARIABLE).trimmed().toLower() != "none"}
+, m_envelope{0.f}
+, m_nextId  {0}
+{
+  const auto device = QMediaDevices::defaultAudioOutput();
+
+  m_format = device.preferredFormat();
+  if(m_format.sampleRate() <= 0)   m_format.setSampleRate(DEFAULT_SAMPLE_RATE);
+  if(m_format.channelCount() <= 0) m_format.setChannelCount(2);
+
+  m_format.setSampleFormat(QAudioFormat::Float);
+  if(!device.isFormatSupported(m_format))
+    m_format.setSampleFormat(QAudioFormat::Int16);
+}
+
+//-----------------------------------------------------------------
+SoundMixer::~SoundMixer()
+{
+  clear();
+}
+
+//-----------------------------------------------------------------
+int SoundMixer::play(const QString &source, int volume, bool loop)
+{
+  // a sound being decoded is played when ready.
+  auto &bank = SoundBank::getInstance();
+  const auto samples = bank.samples(source);
+  if(samples.isEmpty() && !bank.isDecoding(source)) return -1;
+
+  const auto id   = m_nextId++;
+  const auto gain = qBound(0, volume, 100) / 100.f;
+
+  {
+    QMutexLocker lock(&m_mutex);
+
+    // the same looping sound is played once, starting it again out of phase would only make it clash.
+    auto it = std::find_if(m_voices.begin(), m_voices.end(), [&source, loop](const Voice &voice) { return loop && voice.loop && voice.source == source; });
+    if(it != m_voices.end())
+    {
+      it->gains.insert(id, gain);
+      it->gain = std::max(it->gain, gain);
+    }
+    else
+    {
+      m_voices << Voice{source, samples, 0, loop, {{id, gain}}, gain};
+    }
+  }
+
+  if(!isOpen()) open(QIODevice::ReadOnly);
+
+  // without audio output the mix is pulled by the reader of the device.
+  if(!m_output) return id;
+
+  if(!m_sink)
+  {
+    m_sink = std::make_unique<QAudioSink>(QMediaDevices::defaultAudioOutput(), m_format);
+    m_sink->setBufferSize(m_format.bytesForDuration(BUFFER_DURATION));
+  }
+
+  if(m_sink->state() == QAudio::StoppedState)
+    m_sink->start(this);
+
+  return id;
+}
+
+//-----------------------------------------------------------------
+void SoundMixer::stop(int id)
+{
+  {
+    QMutexLocker lock(&m_mutex);
+
+    auto it = std::find_if(m_voices.begin(), m_voices.end(), [id](const Voice &voice) { return voice.gains.contains(id); });
+    if(it == m_voices.end()) return;
+
+    it->gains.remove(id);
+    if(it->gains.isEmpty())
+    {
+      m_voices.erase(it);
+    }
+    else
+    {
+      const auto gains = it->gains.values();
+      it->gain = *std::max_element(gains.cbegin(), gains.cend());
+    }
+  }
+
+  onFinished({id});
+}
+
+//-----------------------------------------------------------------
+bool SoundMixer::isPlaying(int id) const
+{
+  QMutexLocker lock(&m_mutex);
+
+  return std::any_of(m_voices.cbegin(), m_voices.cend(), [id](const Voice &voice) { return voice.gains.contains(id); });
+}
+
+//-----------------------------------------------------------------
+void SoundMixer::clear()
+{
+  {
+    QMutexLocker lock(&m_mutex);
+    m_voices.clear();
+  }
+
+  if(m_sink)
+  {
+    m_sink->stop();
+    m_sink = nullptr;
+  }
+
+  if(isOpen()) close();
+}
+
+//-----------------------------------------------------------------
+void SoundMixer::onSoundReady(const QString &source)
+{
+  setSamples(source, SoundBank::getInstance().samples(source));
+}
+
+//-----------------------------------------------------------------
+void SoundMixer::onSoundFailed(const QString &source)
+{
+  // an alarm is never silent, a missing or invalid sound is replaced by the first embedded one.
+  const auto fallback = SoundBank::source(0);
+  const auto samples = source != fallback ? SoundBank::getInstance().samples(fallback) : QVector<float>();
+
+  QList<int> finished;
+  {
+    QMutexLocker lock(&m_mutex);
+
+    for(auto it = m_voices.begin(); it != m_voices.end();)
+    {
+      if(it->source != source || !it->samples.isEmpty())
+      {
+        ++it;
+        continue;
+      }
+
+      if(source == fallback)
+      {
+        finished << it->gains.keys();
+        it = m_voices.erase(it);
+        continue;
+      }
+
+      // waits for the fallback if it's being decoded.
+      it->source  = fallback;
+      it->samples = samples;
+      ++it;
+    }
+  }
+
+  if(!finished.isEmpty())
+    onFinished(finished);
+}
+
+//-----------------------------------------------------------------
+void SoundMixer::setSamples(const QString &source, const QVector<float> &samples)
+{
+  QMutexLocker lock(&m_mutex);
+
+  for(auto &voice: m_voices)
+  {
+    if(voice.source == source && voice.samples.isEmpty())
+      voice.samples = samples;
+  }
+}
+
+//-----------------------------------------------------------------
+void SoundMixer::onFinished(const QList<int> &ids)
+{
+  for(const auto id: ids)
+    emit finished(id);
+
+  bool idle;
+  {
+    QMutexLocker lock(&m_mutex);
+    idle = m_voices.isEmpty();
+  }
+
+  // the output device is only kept open while there is something to play.
+  if(idle && m_sink)
+    m_sink->stop();
+}
+
+//-----------------------------------------------------------------
+qint64 SoundMixer::readData(char *data, qint64 maxSize)
+{
+  const int channels = m_format.channelCount();
+  const qint64 frames = maxSize / m_format.bytesPerFrame();
+  if(frames <= 0) return 0;
+
+  const qint64 samples = frames * 2;
+  m_mix.fill(0.f, samples);
+  auto mix = m_mix.data();
+
+  QList<int> finished;
+  {
+    QMutexLocker lock(&m_mutex);
+
+    // the muted voices keep advancing, to sound in time when unmuted.
+    std::stable_sort(m_voices.begin(), m_voices.end(), [](const Voice &a, const Voice &b) { return a.gain > b.gain; });
+
+    for(int i = 0; i < m_voices.size(); ++i)
+    {
+      auto &voice = m_voices[i];
+      const auto size = voice.samples.size();
+      if(size == 0) continue;
+
+      const bool mixed = i < MAX_VOICES && voice.gain > 0.f;
+
+      for(qint64 position = 0; position < samples;)
+      {
+        if(voice.position >= size)
+        {
+          if(!voice.loop) break;
+          voice.position = 0;
+        }
+
+        const auto count = std::min<qint64>(samples - position, size - voice.position);
+        if(mixed)
+        {
+          const auto source = voice.samples.constData() + voice.position;
+          for(qint64 j = 0; j < count; ++j)
+            mix[position + j] += source[j] * voice.gain;
+        }
+
+        position += count;
+        voice.position += count;
+      }
+
+      if(!voice.loop && voice.position >= size)
+        finished << voice.gains.keys();
+    }
+
+    m_voices.removeIf([](const Voice &voice) { return !voice.loop && !voice.samples.isEmpty() && voice.position >= voice.samples.size(); });
+  }
+
+  const bool isFloat = m_format.sampleFormat() == QAudioFormat::Float;
+  auto output = data;
+
+  for(qint64 frame = 0; frame < frames; ++frame)
+  {
+    auto left  = mix[frame * 2];
+    auto right = mix[frame * 2 + 1];
+
+    // peak limiter with instant attack, the sum of several loud sounds is scaled down instead of clipped.
+    m_envelope = std::max(std::max(std::abs(left), std::abs(right)), m_envelope * LIMITER_RELEASE);
+    if(m_envelope > 1.f)
+    {
+      left  /= m_envelope;
+      right /= m_envelope;
+    }
+
+    for(int channel = 0; channel < channels; ++channel)
+    {
+      float value = 0.f;
+      if(channels == 1)      value = (left + right) / 2.f;
+      else if(channel == 0)  value = left;
+      else if(channel == 1)  value = right;
+
+      if(isFloat)
+      {
+        std::memcpy(output, &value, sizeof(float));
+        output += sizeof(float);
+      }
+      else
+      {
+        const qint16 sample = qRound(qBound(-1.f, value, 1.f) * 32767.f);
+        std::memcpy(output, &sample, sizeof(qint16));
+        output += sizeof(qint16);
+      }
+    }
+  }
+
+  if(!finished.isEmpty())
+    QMetaObject::invokeMethod(this, [this, finished]() { onFinished(finished); }, Qt::QueuedConnection);
+
+  return frames * m_format.bytesPerFrame();
+}
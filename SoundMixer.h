@@ -0,0 +1,179 @@
+/*
+ File: SoundMixer.h
+ Created on: 19/10/2026
+ Author: Felix de las Pozas Alvarez
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SOUNDMIXER_H_
+#define SOUNDMIXER_H_
+
+// Qt
+#include <QIODevice>
+#include <QAudioFormat>
+#include <QMutex>
+#include <QVector>
+#include <QMap>
+
+// C++
+#include <memory>
+
+class QAudioSink;
+
+/** \class SoundMixer
+ * \brief Mixes the sounds being played into a single audio output stream. Alarms ringing the same
+ *        looping sound share a voice at the loudest of their volumes, and only the loudest MAX_VOICES
+ *        voices are mixed, so the cost doesn't grow with the number of alarms. A limiter keeps the
+ *        sum from clipping.
+ *
+ *        The audio output pulls the samples from the mixer with readData(), possibly from its own thread.
+ *        With the MULTIALARM_AUDIO_OUTPUT environment variable set to "none" there is no audio output, and
+ *        the mix is only read by the reader of the device.
+ *
+ */
+class SoundMixer
+: public QIODevice
+{
+    Q_OBJECT
+  public:
+    /** \brief Gets the SoundMixer singleton instance.
+     *
+     */
+    static SoundMixer &getInstance();
+
+    /** \brief Deleted copy constructor to avoid copying the singleton.
+     *
+     */
+    SoundMixer(SoundMixer const&) = delete;
+
+    /** \brief Deleted operator= to avoid copying the singleton.
+     *
+     */
+    void operator=(SoundMixer const&) = delete;
+
+    /** \brief Returns the sample rate of the mix.
+     *
+     */
+    int sampleRate() const
+    { return m_format.sampleRate(); }
+
+    /** \brief Returns the audio format of the mix read from the device.
+     *
+     */
+    const QAudioFormat &format() const
+    { return m_format; }
+
+    /** \brief Starts playing the sound and returns the identifier of the playback, or -1 on error. A sound
+     *         not yet decoded starts when ready, the first embedded sound is played instead if it fails.
+     * \param[in] source sound source, see SoundBank.
+     * \param[in] volume volume in [0-100].
+     * \param[in] loop true to play the sound until stopped and false to play it once.
+     *
+     */
+    int play(const QString &source, int volume, bool loop);
+
+    /** \brief Stops the playback.
+     * \param[in] id playback identifier.
+     *
+     */
+    void stop(int id);
+
+    /** \brief Returns true if the playback hasn't finished.
+     * \param[in] id playback identifier.
+     *
+     */
+    bool isPlaying(int id) const;
+
+    /** \brief Stops all the sounds and releases the audio output. Must be called before the application
+     *         is destroyed.
+     *
+     */
+    void clear();
+
+    virtual bool isSequential() const override
+    { return true; }
+
+  public slots:
+    /** \brief Sets the samples of the voices waiting for the sound.
+     * \param[in] source sound source.
+     *
+     */
+    void onSoundReady(const QString &source);
+
+    /** \brief Sets the first embedded sound to the voices waiting for the sound, or stops them if the
+     *         failed sound is the first embedded one.
+     * \param[in] source sound source.
+     *
+     */
+    void onSoundFailed(const QString &source);
+
+  signals:
+    /** \brief Signals the end of a playback, finished or stopped.
+     * \param[out] id playback identifier.
+     *
+     */
+    void finished(int id);
+
+  protected:
+    virtual qint64 readData(char *data, qint64 maxSize) override;
+
+    virtual qint64 writeData(const char *, qint64) override
+    { return -1; }
+
+  private:
+    /** \brief SoundMixer class private constructor.
+     *
+     */
+    SoundMixer();
+
+    /** \brief SoundMixer class private destructor.
+     *
+     */
+    virtual ~SoundMixer();
+
+    /** \brief Emits finished() for the playbacks and stops the audio output if nothing is playing.
+     * \param[in] ids playback identifiers.
+     *
+     */
+    void onFinished(const QList<int> &ids);
+
+    /** \brief Sets the samples of the voices waiting for the sound.
+     * \param[in] source sound source.
+     * \param[in] samples sound samples.
+     *
+     */
+    void setSamples(const QString &source, const QVector<float> &samples);
+
+    struct Voice
+    {
+      QString           source;   /** sound source.                                     */
+      QVector<float>    samples;  /** interleaved stereo samples, empty until decoded.  */
+      qsizetype         position; /** next sample.                                      */
+      bool              loop;     /** true if the sound loops.                          */
+      QMap<int, float>  gains;    /** gain of each playback of the voice.               */
+      float             gain;     /** voice gain, the maximum of the playback gains.    */
+    };
+
+    QAudioFormat                m_format;   /** audio output format.                            */
+    const bool                  m_output;   /** false if the mix isn't played, only read.       */
+    std::unique_ptr<QAudioSink> m_sink;     /** audio output.                                   */
+    QList<Voice>                m_voices;   /** voices being played.                            */
+    mutable QMutex              m_mutex;    /** protects the voices.                            */
+    QVector<float>              m_mix;      /** mix buffer, stereo.                             */
+    float                       m_envelope; /** limiter envelope.                               */
+    int                         m_nextId;   /** identifier of the next playback.                */
+};
+
+#endif // SOUNDMIXER_H_
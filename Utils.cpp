@@ -23,6 +23,58 @@
 // Qt
 #include <QPainter>
 #include <QPainterPath>
+#include <QGuiApplication>
+#include <QScreen>
+#include <QPixmap>
+#include <QHash>
+#include <QSet>
+
+const int SWATCH_SIZE = 32; // color swatch size in device independent pixels.
+
+//-----------------------------------------------------------------
+const QIcon Utils::colorSwatch(const QString &color)
+{
+  static QHash<QString, QIcon> swatches;
+
+  auto it = swatches.constFind(color);
+  if(it != swatches.constEnd()) return it.value();
+
+  // sharp on every screen, a lower ratio is scaled down by the icon.
+  qreal ratio = qApp->devicePixelRatio();
+  for(const auto screen: QGuiApplication::screens())
+    ratio = std::max(ratio, screen->devicePixelRatio());
+
+  QPixmap pixmap(QSize{SWATCH_SIZE, SWATCH_SIZE} * ratio);
+  pixmap.setDevicePixelRatio(ratio);
+  pixmap.fill(QColor(color));
+
+  return swatches.insert(color, QIcon(pixmap)).value();
+}
+
+//-----------------------------------------------------------------
+const QString Utils::colorDisplayName(const QString &color)
+{
+  QStringList words = color.split(" ", Qt::SkipEmptyParts);
+  for (QString &word : words)
+    word.front() = word.front().toUpper();
+
+  return words.join(" ");
+}
+
+//-----------------------------------------------------------------
+bool Utils::isColorName(const QString &color)
+{
+  static const auto names = []()
+  {
+    QSet<QString> result;
+    for(const auto &name: QColor::colorNames())
+      result.insert(name.toLower());
+
+    return result;
+  }();
+
+  return names.contains(color);
+}
 
 //-----------------------------------------------------------------
 Utils::ClickableHoverLabel::ClickableHoverLabel(QWidget *parent, Qt::WindowFlags f)
@@ -98,7 +150,13 @@ void DrawFrame::paintEvent(QPaintEvent *p)
   completedPath.addRoundedRect(rect, 5, 5);
   painter.fillPath(completedPath, completedGradient);
 
-  painter.drawRoundedRect(this->rect(), 5, 5);
+  if(m_selected)
+  {
+    painter.setPen(QPen(palette().color(QPalette::Highlight), 3));
+    painter.drawRoundedRect(this->rect().adjusted(1, 1, -2, -2), 5, 5);
+  }
+  else
+    painter.drawRoundedRect(this->rect(), 5, 5);
 
   painter.end();
 
@@ -24,9 +24,29 @@
 #include <QLabel>
 #include <QFrame>
 #include <QColor>
+#include <QIcon>
 
 namespace Utils
 {
+  /** \brief Returns the icon with the color swatch. Each swatch is rendered once per process at the highest
+   *         device pixel ratio of the screens and shared by all the widgets.
+   * \param[in] color color name belonging to QColor::colorNames().
+   *
+   */
+  const QIcon colorSwatch(const QString &color);
+
+  /** \brief Returns the name of the color to show in the UI, with the first letter in uppercase.
+   * \param[in] color color name belonging to QColor::colorNames().
+   *
+   */
+  const QString colorDisplayName(const QString &color);
+
+  /** \brief Returns true if the color is one of QColor::colorNames(), the lowercase names used by the alarms.
+   * \param[in] color color name.
+   *
+   */
+  bool isColorName(const QString &color);
+
   /** \class ClickableHoverLabel
   * \brief ClickableLabel subclass that changes the mouse cursor when hovered.
   *
@@ -107,6 +127,13 @@ class DrawFrame
     void setColors(const QColor &a, const QColor &b)
     { m_color = a; m_shineColor = b; }
 
+    /** \brief Sets the selection state, selected frames draw a highlighted border.
+     * \param[in] value true to draw as selected and false otherwise.
+     *
+     */
+    void setSelected(const bool value)
+    { m_selected = value; }
+
   protected:
     void paintEvent(QPaintEvent *p) override;
 
@@ -114,6 +141,7 @@ class DrawFrame
     qreal m_progress = 0;                        /** progress value for drawing the gradients. */
     QColor m_color = QColor(0, 0, 0);            /** first gradient color. */
     QColor m_shineColor = QColor(255, 255, 255); /** second gradient color. */
+    bool m_selected = false;                     /** true to draw the selection border. */
 };
 
 #endif // UTILS_H_
\ No newline at end of file
@@ -0,0 +1,207 @@
+/*
+ File: AlarmGroupTest.cpp
+ Created on: 19/10/2026
+ Author: Felix de las Pozas Alvarez
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Project
+#include <AlarmGroupWidget.h>
+#include <AlarmJson.h>
+#include <AlarmWidget.h>
+#include <MultiAlarm.h>
+
+// Qt
+#include <QtTest>
+#include <QTemporaryDir>
+
+const QString GROUP = "Group";
+
+/** \class AlarmGroupTest
+ * \brief Checks the visibility of the alarms added to a collapsed group once it's expanded. The main
+ *        window uses a settings INI file next to the test executable, created empty for the test.
+ *
+ */
+class AlarmGroupTest
+: public QObject
+{
+    Q_OBJECT
+  private slots:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void importedAlarmShownOnExpand();
+    void movedAlarmShownOnExpand();
+
+  private:
+    /** \brief Imports a timer alarm into the main window with a JSON file. Returns true on success.
+     * \param[in] name alarm name.
+     * \param[in] color alarm color.
+     * \param[in] group alarm group name, empty if not grouped.
+     *
+     */
+    bool importAlarm(const QString &name, const QString &color, const QString &group);
+
+    /** \brief Returns the alarm widget with the given name, or nullptr if it doesn't exist.
+     * \param[in] name alarm name.
+     *
+     */
+    AlarmWidget *alarm(const QString &name) const;
+
+    /** \brief Returns the group widget with the given name, or nullptr if it doesn't exist.
+     * \param[in] name group name.
+     *
+     */
+    AlarmGroupWidget *group(const QString &name) const;
+
+    /** \brief Removes the settings INI file and the data files next to it.
+     *
+     */
+    void removeSettings();
+
+    QTemporaryDir m_dir;              /** directory of the imported JSON files. */
+    MultiAlarm   *m_window = nullptr; /** main window.                           */
+};
+
+//-----------------------------------------------------------------
+void AlarmGroupTest::initTestCase()
+{
+  // must be set before the LogiLED and mixer singletons are created.
+  qputenv("MULTIALARM_LED_BACKEND", "none");
+  qputenv("MULTIALARM_AUDIO_OUTPUT", "none");
+
+  QVERIFY(m_dir.isValid());
+
+  removeSettings();
+
+  QFile ini(QDir(QCoreApplication::applicationDirPath()).absoluteFilePath("MultiAlarm.ini"));
+  QVERIFY(ini.open(QIODevice::WriteOnly));
+  ini.close();
+
+  m_window = new MultiAlarm();
+  m_window->show();
+  QVERIFY(QTest::qWaitForWindowExposed(m_window));
+}
+
+//-----------------------------------------------------------------
+void AlarmGroupTest::cleanupTestCase()
+{
+  delete m_window;
+  m_window = nullptr;
+
+  removeSettings();
+}
+
+//-----------------------------------------------------------------
+void AlarmGroupTest::removeSettings()
+{
+  const QDir dir(QCoreApplication::applicationDirPath());
+  for(const auto &filename: {"MultiAlarm.ini", "MultiAlarm.journal", "MultiAlarm.alarms"})
+    dir.remove(filename);
+}
+
+//-----------------------------------------------------------------
+bool AlarmGroupTest::importAlarm(const QString &name, const QString &color, const QString &group)
+{
+  AlarmConfiguration conf;
+  conf.name      = name;
+  conf.message   = name;
+  conf.color     = color;
+  conf.group     = group;
+  conf.isTimer   = true;
+  conf.timerTime = QTime(1,0,0);
+
+  const auto filename = m_dir.filePath(name + ".json");
+
+  QFile file(filename);
+  if(!file.open(QIODevice::WriteOnly)) return false;
+
+  AlarmJson::Writer writer(&file);
+  if(!writer.write(conf) || !writer.finish()) return false;
+  file.close();
+
+  QStringList errors;
+  return m_window->importJson(filename, errors) == 1 && errors.isEmpty();
+}
+
+//-----------------------------------------------------------------
+AlarmWidget *AlarmGroupTest::alarm(const QString &name) const
+{
+  for(auto widget: m_window->findChildren<AlarmWidget *>())
+    if(widget->name() == name) return widget;
+
+  return nullptr;
+}
+
+//-----------------------------------------------------------------
+AlarmGroupWidget *AlarmGroupTest::group(const QString &name) const
+{
+  for(auto widget: m_window->findChildren<AlarmGroupWidget *>())
+    if(widget->name() == name) return widget;
+
+  return nullptr;
+}
+
+//-----------------------------------------------------------------
+void AlarmGroupTest::importedAlarmShownOnExpand()
+{
+  QVERIFY(importAlarm("A", "red", GROUP));
+
+  auto groupWidget = group(GROUP);
+  QVERIFY(groupWidget);
+
+  groupWidget->setCollapsed(true);
+
+  QVERIFY(importAlarm("B", "blue", GROUP));
+
+  auto added = alarm("B");
+  QVERIFY(added);
+  QVERIFY(groupWidget->contains(added));
+  QVERIFY(!added->isVisible());
+
+  groupWidget->setCollapsed(false);
+
+  QVERIFY(alarm("A")->isVisible());
+  QVERIFY(added->isVisible());
+}
+
+//-----------------------------------------------------------------
+void AlarmGroupTest::movedAlarmShownOnExpand()
+{
+  QVERIFY(importAlarm("C", "green", QString()));
+
+  auto groupWidget = group(GROUP);
+  QVERIFY(groupWidget);
+
+  groupWidget->setCollapsed(true);
+
+  // modified by the user to belong to the collapsed group.
+  auto moved = alarm("C");
+  QVERIFY(moved);
+
+  auto conf = moved->alarmConfiguration();
+  conf.group = GROUP;
+  moved->reconfigure(conf);
+
+  QVERIFY(groupWidget->contains(moved));
+  QVERIFY(!moved->isVisible());
+
+  groupWidget->setCollapsed(false);
+
+  QVERIFY(moved->isVisible());
+}
+
+QTEST_MAIN(AlarmGroupTest)
+#include "AlarmGroupTest.moc"
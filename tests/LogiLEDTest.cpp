@@ -0,0 +1,257 @@
+/*
+ File: LogiLEDTest.cpp
+ Created on: 19/10/2026
+ Author: Felix de las Pozas Alvarez
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Project
+#include <LogiLED.h>
+#include <MockLedDevice.h>
+
+// Qt
+#include <QtTest>
+
+const int SETTLE_TIME = 200; // milliseconds to wait for the LED thread to write any remaining frame.
+
+const QColor RED{Qt::red};
+const QColor BLUE{Qt::blue};
+const QColor BLACK{Qt::black};
+
+/** \class LogiLEDTest
+ * \brief Checks the device calls made by the LED thread for the changes of the keyboard lights, using the
+ *        mock backend. Animations are disabled so every frame is written at once.
+ *
+ */
+class LogiLEDTest
+: public QObject
+{
+    Q_OBJECT
+  private slots:
+    void initTestCase();
+    void cleanupTestCase();
+    void init();
+
+    void registerWritesOneBitmap();
+    void unchangedUpdateIsNotWritten();
+    void changedUpdatesWriteOneBitmapEach();
+    void unregisterLastRestores();
+    void batchWritesOneBitmap();
+    void zoneBindingWritesOneComposedBitmap();
+
+  private:
+    /** \brief Returns the number of setBitmap() calls.
+     *
+     */
+    int bitmaps() const
+    { return static_cast<int>(m_device->bitmaps().size()); }
+
+    /** \brief Returns the number of excludeKeys() calls, the only device calls that aren't restores or bitmaps.
+     *
+     */
+    int exclusions() const
+    { return m_device->calls() - m_device->restores() - bitmaps(); }
+
+    /** \brief Returns the BGRA pixel of the key in the last written bitmap as a color.
+     * \param[in] key keyboard key.
+     *
+     */
+    QColor lastColor(const LedDevice::Key key) const;
+
+    MockLedDevice *m_device = nullptr; /** mock backend of the LogiLED singleton. */
+};
+
+//-----------------------------------------------------------------
+void LogiLEDTest::initTestCase()
+{
+  // must be set before the LogiLED singleton is created.
+  qputenv("MULTIALARM_LED_BACKEND", "mock");
+
+  auto &logiled = LogiLED::getInstance();
+  QVERIFY(LogiLED::isAvailable());
+
+  m_device = dynamic_cast<MockLedDevice *>(logiled.device());
+  QVERIFY(m_device);
+
+  logiled.setFrameRate(0);
+}
+
+//-----------------------------------------------------------------
+void LogiLEDTest::cleanupTestCase()
+{
+  LogiLED::getInstance().finish();
+}
+
+//-----------------------------------------------------------------
+void LogiLEDTest::init()
+{
+  auto &logiled = LogiLED::getInstance();
+
+  for(const auto &id: {"A", "B", "C"})
+    logiled.unregisterItem(id);
+
+  logiled.setZoneBinding(LogiLED::Zone::FUNCTION_KEYS, LogiLED::Binding::ROTATION);
+  for(auto zone: {LogiLED::Zone::NUMBER_KEYS, LogiLED::Zone::LETTER_KEYS, LogiLED::Zone::NAVIGATION_KEYS, LogiLED::Zone::NUMERIC_KEYPAD})
+    logiled.setZoneBinding(zone, LogiLED::Binding::NONE);
+
+  QTest::qWait(SETTLE_TIME);
+  m_device->clear();
+}
+
+//-----------------------------------------------------------------
+QColor LogiLEDTest::lastColor(const LedDevice::Key key) const
+{
+  const auto bitmaps = m_device->bitmaps();
+  if(bitmaps.isEmpty()) return QColor();
+
+  const auto pixel = bitmaps.last().bitmap.data() + LedDevice::bitmapOffset(key);
+  return QColor(pixel[2], pixel[1], pixel[0]);
+}
+
+//-----------------------------------------------------------------
+void LogiLEDTest::registerWritesOneBitmap()
+{
+  QVERIFY(LogiLED::getInstance().registerItem("A", 100, RED, BLACK));
+
+  QTRY_COMPARE(bitmaps(), 1);
+  QTest::qWait(SETTLE_TIME);
+
+  // the first frame of the session excludes the keys not shown, then writes all the keys at once.
+  QCOMPARE(bitmaps(), 1);
+  QCOMPARE(exclusions(), 1);
+  QCOMPARE(m_device->restores(), 0);
+  QCOMPARE(static_cast<int>(m_device->excluded().size()), LedDevice::KEY_COUNT - static_cast<int>(LogiLED::zoneKeys(LogiLED::Zone::FUNCTION_KEYS).size()));
+  QCOMPARE(lastColor(LedDevice::Key::F1), RED);
+}
+
+//-----------------------------------------------------------------
+void LogiLEDTest::unchangedUpdateIsNotWritten()
+{
+  auto &logiled = LogiLED::getInstance();
+  QVERIFY(logiled.registerItem("A", 50, RED, BLACK));
+  QTRY_COMPARE(bitmaps(), 1);
+  QTest::qWait(SETTLE_TIME);
+  m_device->clear();
+
+  QVERIFY(logiled.updateItem("A", 50, RED, BLACK));
+  QTest::qWait(SETTLE_TIME);
+
+  QCOMPARE(m_device->calls(), 0);
+}
+
+//-----------------------------------------------------------------
+void LogiLEDTest::changedUpdatesWriteOneBitmapEach()
+{
+  auto &logiled = LogiLED::getInstance();
+  QVERIFY(logiled.registerItem("A", 0, RED, BLACK));
+  QTRY_COMPARE(bitmaps(), 1);
+  QTest::qWait(SETTLE_TIME);
+  m_device->clear();
+
+  QVERIFY(logiled.updateItem("A", 50));
+  QTRY_COMPARE(bitmaps(), 1);
+
+  QVERIFY(logiled.updateItem("A", 100));
+  QTRY_COMPARE(bitmaps(), 2);
+  QTest::qWait(SETTLE_TIME);
+
+  // the keys are excluded once per session, the following frames are only bitmaps.
+  QCOMPARE(bitmaps(), 2);
+  QCOMPARE(exclusions(), 0);
+  QCOMPARE(m_device->restores(), 0);
+  QCOMPARE(lastColor(LedDevice::Key::PAUSE_BREAK), RED);
+}
+
+//-----------------------------------------------------------------
+void LogiLEDTest::unregisterLastRestores()
+{
+  auto &logiled = LogiLED::getInstance();
+  QVERIFY(logiled.registerItem("A", 100, RED, BLACK));
+  QTRY_COMPARE(bitmaps(), 1);
+  QTest::qWait(SETTLE_TIME);
+  m_device->clear();
+
+  QVERIFY(logiled.unregisterItem("A"));
+  QTRY_COMPARE(m_device->restores(), 1);
+  QTest::qWait(SETTLE_TIME);
+
+  QCOMPARE(m_device->calls(), 1);
+  QVERIFY(m_device->excluded().isEmpty());
+}
+
+//-----------------------------------------------------------------
+void LogiLEDTest::batchWritesOneBitmap()
+{
+  auto &logiled = LogiLED::getInstance();
+
+  logiled.beginBatch();
+  QVERIFY(logiled.registerItem("A", 100, RED, BLACK));
+  QVERIFY(logiled.registerItem("B", 100, BLUE, BLACK));
+  QVERIFY(logiled.registerItem("C", 100, BLUE, BLACK));
+  QVERIFY(logiled.updateItem("A", 50));
+  QTest::qWait(SETTLE_TIME);
+
+  QCOMPARE(m_device->calls(), 0);
+
+  logiled.endBatch();
+  QTRY_COMPARE(bitmaps(), 1);
+  QTest::qWait(SETTLE_TIME);
+
+  QCOMPARE(bitmaps(), 1);
+  QCOMPARE(exclusions(), 1);
+  QCOMPARE(m_device->restores(), 0);
+}
+
+//-----------------------------------------------------------------
+void LogiLEDTest::zoneBindingWritesOneComposedBitmap()
+{
+  auto &logiled = LogiLED::getInstance();
+  QVERIFY(logiled.registerItem("A", 100, RED, BLACK, "Group"));
+  QVERIFY(logiled.registerItem("B", 100, BLUE, BLACK));
+  QTRY_COMPARE(bitmaps(), 1);
+  QTest::qWait(SETTLE_TIME);
+  m_device->clear();
+
+  // the bound alarm leaves the rotation of the function keys.
+  logiled.setZoneBinding(LogiLED::Zone::NUMBER_KEYS, LogiLED::Binding::ALARM, "A");
+  QTRY_COMPARE(bitmaps(), 1);
+  QTest::qWait(SETTLE_TIME);
+
+  // a different set of keys starts a new session, then both zones are written in a single bitmap.
+  QCOMPARE(m_device->restores(), 1);
+  QCOMPARE(exclusions(), 1);
+  QCOMPARE(bitmaps(), 1);
+  QCOMPARE(lastColor(LedDevice::Key::F1), BLUE);
+  QCOMPARE(lastColor(LedDevice::Key::TILDE), RED);
+
+  const auto excluded = m_device->excluded();
+  QVERIFY(!excluded.contains(LedDevice::Key::F1));
+  QVERIFY(!excluded.contains(LedDevice::Key::TILDE));
+  QVERIFY(excluded.contains(LedDevice::Key::Q));
+
+  // binding the group of the alarm to a second zone shows it there too, still a single bitmap.
+  m_device->clear();
+  logiled.setZoneBinding(LogiLED::Zone::NUMERIC_KEYPAD, LogiLED::Binding::GROUP, "Group");
+  QTRY_COMPARE(bitmaps(), 1);
+  QTest::qWait(SETTLE_TIME);
+
+  QCOMPARE(bitmaps(), 1);
+  QCOMPARE(exclusions(), 1);
+  QCOMPARE(lastColor(LedDevice::Key::TILDE), RED);
+  QCOMPARE(lastColor(LedDevice::Key::NUM_LOCK), RED);
+}
+
+QTEST_GUILESS_MAIN(LogiLEDTest)
+#include "LogiLEDTest.moc"
@@ -0,0 +1,146 @@
+/*
+ File: SoundMixerTest.cpp
+ Created on: 19/10/2026
+ Author: Felix de las Pozas Alvarez
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Project
+#include <Alarm.h>
+#include <SoundBank.h>
+#include <SoundMixer.h>
+
+// Qt
+#include <QtTest>
+#include <QElapsedTimer>
+#include <QTimer>
+
+// C++
+#include <algorithm>
+#include <cmath>
+
+const int PULL_PERIOD     = 25;    // milliseconds between reads of the mix, like the audio output does.
+const int MAX_LATENCY     = 100;   // milliseconds, the duration of the audio output buffer.
+const float AUDIBLE_LEVEL = 0.01f; // minimum absolute sample value of an audible frame.
+
+/** \class SoundMixerTest
+ * \brief Measures the time from the timeout of an alarm to the first buffer of the mix with its sound.
+ *        The mix is pulled by the test at the pace of an audio output instead of played.
+ *
+ */
+class SoundMixerTest
+: public QObject
+{
+    Q_OBJECT
+  private slots:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void timeoutToFirstMixedBuffer();
+};
+
+//-----------------------------------------------------------------
+void SoundMixerTest::initTestCase()
+{
+  // must be set before the mixer is created.
+  qputenv("MULTIALARM_AUDIO_OUTPUT", "none");
+
+  // an embedded sound is decoded when requested, so the alarm plays it without waiting for the decoder.
+  QVERIFY(!SoundBank::getInstance().samples(SoundBank::source(0)).isEmpty());
+}
+
+//-----------------------------------------------------------------
+void SoundMixerTest::cleanupTestCase()
+{
+  SoundMixer::getInstance().clear();
+  SoundBank::getInstance().clear();
+}
+
+//-----------------------------------------------------------------
+void SoundMixerTest::timeoutToFirstMixedBuffer()
+{
+  auto &mixer = SoundMixer::getInstance();
+  const auto &format = mixer.format();
+  const auto source  = SoundBank::source(0);
+  const auto samples = SoundBank::getInstance().samples(source);
+
+  // first audible frame of the sound, interleaved stereo.
+  qint64 firstFrame = 0;
+  while(2 * firstFrame + 1 < samples.size() &&
+        std::max(std::abs(samples.at(2 * firstFrame)), std::abs(samples.at(2 * firstFrame + 1))) < AUDIBLE_LEVEL)
+    ++firstFrame;
+  QVERIFY(2 * firstFrame + 1 < samples.size());
+
+  const auto bytes         = format.bytesForDuration(PULL_PERIOD * 1000);
+  const auto framesPerRead = format.framesForBytes(bytes);
+
+  QElapsedTimer clock;
+  QByteArray stream;
+  qint64 latency = -1;
+  int id = -1;
+
+  Alarm alarm(Alarm::AlarmTime{0,0,0,1}, false);
+  connect(&alarm, &Alarm::timeout, this, [&]()
+  {
+    clock.start();
+    id = mixer.play(source, 100, false);
+  });
+
+  QTimer pull;
+  pull.setTimerType(Qt::PreciseTimer);
+  pull.setInterval(PULL_PERIOD);
+  connect(&pull, &QTimer::timeout, this, [&]()
+  {
+    if(!clock.isValid() || !mixer.isOpen()) return;
+
+    stream += mixer.read(bytes);
+    if(latency < 0) latency = clock.elapsed();
+  });
+
+  pull.start();
+  alarm.start();
+
+  QTRY_VERIFY_WITH_TIMEOUT(format.framesForBytes(stream.size()) > firstFrame + framesPerRead, 5000);
+  pull.stop();
+
+  QVERIFY(id >= 0);
+
+  // the sound must start in the first buffer read after the timeout, not in a later one.
+  qint64 audibleFrame = -1;
+  const auto frames = format.framesForBytes(stream.size());
+  for(qint64 frame = 0; frame < frames && audibleFrame < 0; ++frame)
+  {
+    for(int channel = 0; channel < format.channelCount(); ++channel)
+    {
+      const auto sample = stream.constData() + format.bytesForFrames(frame) + channel * format.bytesPerSample();
+      if(std::abs(format.normalizedSampleValue(sample)) >= AUDIBLE_LEVEL)
+      {
+        audibleFrame = frame;
+        break;
+      }
+    }
+  }
+
+  QVERIFY2(audibleFrame >= 0, "The sound wasn't mixed.");
+  QVERIFY2(audibleFrame - firstFrame < framesPerRead, "The sound wasn't mixed in the first buffer after the timeout.");
+
+  qInfo() << "First mixed buffer" << latency << "ms after the alarm timeout.";
+  QVERIFY2(latency <= MAX_LATENCY, qPrintable(QString("Latency %1 ms above %2 ms.").arg(latency).arg(MAX_LATENCY)));
+
+  mixer.stop(id);
+}
+
+QTEST_GUILESS_MAIN(SoundMixerTest)
+#include "SoundMixerTest.moc"